@@ -239,11 +239,7 @@ public:
 		CHECK_FADA(fada_calcfft(m_fada));
 		
 		// Generate a channel-specific FFT on each buffer.
-		for (size_t i = 0, sz = m_buffers.size(); i < sz; ++i)
-		{
-			CHECK_FADA(fada_usefftbuffer(m_fada, m_buffers[i]));
-			CHECK_FADA(fada_calcfft_channel(m_fada, i));
-		}
+		CHECK_FADA(fada_calcfft_allchannels(m_fada, &m_buffers[0]));
 	}
 
 
@@ -40,13 +40,30 @@
 
 
 //////////////////////////////////////////////////
+/// \brief Create a new libfada manager, checking that the library was built with the same binary interface as the caller.
+/// Returns NULL if manager could not be created, or if \p abi_version doesn't match the library's \ref FADA_ABI_VERSION.
+/// 
+/// Call it through \ref fada_newmanager, which passes the version of the headers in use.
+/// 
+/// \param abi_version The \ref FADA_ABI_VERSION the caller was built with.
+/// 
+/// \return Returns a new libfada audio manager.
+/// 
+/// \see fada_newmanager
+/// \see fada_closemanager
+FADA_API fada_Manager* fada_newmanager_abi(unsigned int abi_version);
+
+//////////////////////////////////////////////////
+/// \def fada_newmanager
 /// \brief Create a new libfada manager.
 /// Returns NULL if manager could not be created.
 /// 
+/// Programs built against headers of an older binary interface fail to link rather than misreading 64-bit positions.
+/// 
 /// \return Returns a new libfada audio manager.
 /// 
 /// \see fada_closemanager
-FADA_API fada_Manager* fada_newmanager();
+#define fada_newmanager() fada_newmanager_abi(FADA_ABI_VERSION)
 
 //////////////////////////////////////////////////
 /// \brief Close an existing libfada audio manager, freeing its resources.
@@ -79,8 +96,10 @@ FADA_API void fada_closemanager(fada_Manager* m);
 ///         \li \ref FADA_ERROR_NOT_ENOUGH_MEMORY
 ///         \li \ref FADA_ERROR_NOT_MULTIPLE_OF_CHANNELS
 ///         \li \ref FADA_ERROR_SUCCESS
+///         \li \ref FADA_ERROR_WOULD_ALLOCATE
 /// 
 /// \see fada_bindstream
+/// \see fada_bindringstream
 /// \see fada_pushsamples
 FADA_API fada_Error fada_bindsamples(fada_Manager* m, void* data, fada_Pos sample_count, fada_Boolean copy_data, fada_TSample sample_type, unsigned int sample_rate, unsigned int channels);
 
@@ -89,6 +108,7 @@ FADA_API fada_Error fada_bindsamples(fada_Manager* m, void* data, fada_Pos sampl
 /// 
 /// Similar to fada_bindsamples, except no samples are bound to the manager until \ref fada_pushsamples is called.
 /// If successful, the manager will be ready to use for analysis.
+/// Pushed samples are held until trimmed, see \ref fada_setretention to have long-running streams trimmed automatically.
 /// 
 /// \param m The manager to bind.
 /// \param sample_type The sample type of audio data.
@@ -103,11 +123,189 @@ FADA_API fada_Error fada_bindsamples(fada_Manager* m, void* data, fada_Pos sampl
 ///         \li \ref FADA_ERROR_MANAGER_NOT_READY
 ///         \li \ref FADA_ERROR_NOT_ENOUGH_MEMORY
 ///         \li \ref FADA_ERROR_SUCCESS
+///         \li \ref FADA_ERROR_WOULD_ALLOCATE
 /// 
 /// \see fada_bindsamples
 /// \see fada_pushsamples
+/// \see fada_setretention
 FADA_API fada_Error fada_bindstream(fada_Manager* m, fada_TSample sample_type, unsigned int sample_rate, unsigned int channels);
 
+//////////////////////////////////////////////////
+/// \brief Bind audio information to the manager and back it with a preallocated ring buffer.
+/// 
+/// Similar to fada_bindstream, except pushed samples are always copied into a ring buffer owned by the manager
+/// instead of being stored as separate chunks. Once bound, pushing and trimming samples never allocates memory.
+/// The ring holds at least \p capacity_frames frames; the capacity is rounded up to a power of two.
+/// The ring takes up twice its capacity in memory, and capacities too large to allocate at all fail with \ref FADA_ERROR_INVALID_SIZE.
+/// Samples must be released with \ref fada_trimchunks to make room for new samples, otherwise
+/// \ref fada_pushsamples will fail with \ref FADA_ERROR_BUFFER_FULL.
+/// 
+/// A manager bound this way may be fed from one thread while another thread analyzes it, without any locking.
+/// The feeding thread may only call \ref fada_pushsamples. All other functions must be called from the analyzing thread,
+/// which picks up newly pushed samples on its next analysis, \ref fada_continue, \ref fada_setposition or \ref fada_trimchunks call.
+/// 
+/// \param m The manager to bind.
+/// \param sample_type The sample type of audio data.
+/// \param sample_rate The sample rate of the audio data in Hertz. For example, \c 44100.
+/// \param channels The number of audio channels. For example, \c 1 would be mono audio, \c 2 would be stereo audio, etc.
+/// \param capacity_frames The minimum number of frames the ring buffer can hold.
+/// 
+/// \return Returns one of the following error signals:
+///         \li \ref FADA_ERROR_INVALID_CHANNEL
+///         \li \ref FADA_ERROR_INVALID_SAMPLE_RATE
+///         \li \ref FADA_ERROR_INVALID_SIZE
+///         \li \ref FADA_ERROR_INVALID_TYPE
+///         \li \ref FADA_ERROR_MANAGER_NOT_READY
+///         \li \ref FADA_ERROR_NOT_ENOUGH_MEMORY
+///         \li \ref FADA_ERROR_SUCCESS
+///         \li \ref FADA_ERROR_WOULD_ALLOCATE
+/// 
+/// \see fada_bindstream
+/// \see fada_pushsamples
+/// \see fada_trimchunks
+FADA_API fada_Error fada_bindringstream(fada_Manager* m, fada_TSample sample_type, unsigned int sample_rate, unsigned int channels, fada_Pos capacity_frames);
+
+//////////////////////////////////////////////////
+/// \brief Bind a ring stream and reserve everything analysis needs, so the manager never allocates again.
+/// 
+/// Meant for audio callbacks and other real-time threads. Behaves like \ref fada_bindringstream, and additionally
+/// reserves a window buffer of \p max_window_frames frames and, unless \p max_fft_size is \c 0, creates the internal FFT buffer
+/// of \p max_fft_size values with its plan, using the precision set by \ref fada_setffttype beforehand.
+/// The window starts at \ref FADA_DEFAULT_WINDOWSIZE frames, or \p max_window_frames if that is smaller.
+/// 
+/// Once bound, no function called on the manager allocates or frees memory, takes a lock, or waits, apart from \ref fada_closemanager.
+/// Calls that would have to do so fail with \ref FADA_ERROR_WOULD_ALLOCATE instead, such as growing the window past \p max_window_frames,
+/// changing the FFT buffer or its precision, binding the manager again, or running \ref fada_analyzeall_threaded on more than one thread.
+/// 
+/// \param m The manager to bind.
+/// \param sample_type The sample type of audio data.
+/// \param sample_rate The sample rate of the audio data in Hertz. For example, \c 44100.
+/// \param channels The number of audio channels. For example, \c 1 would be mono audio, \c 2 would be stereo audio, etc.
+/// \param capacity_frames The minimum number of frames the ring buffer can hold.
+/// \param max_window_frames The largest window size (in frames) that will be set with \ref fada_setwindowframes.
+/// \param max_fft_size The size of the internal FFT buffer. If not a power of 2, the closest power of 2 below it is used. Set to \c 0 if no FFT is needed.
+/// 
+/// \return Returns one of the following error signals:
+///         \li \ref FADA_ERROR_INVALID_CHANNEL
+///         \li \ref FADA_ERROR_INVALID_SAMPLE_RATE
+///         \li \ref FADA_ERROR_INVALID_SIZE
+///         \li \ref FADA_ERROR_INVALID_TYPE
+///         \li \ref FADA_ERROR_MANAGER_NOT_READY
+///         \li \ref FADA_ERROR_NOT_ENOUGH_MEMORY
+///         \li \ref FADA_ERROR_SUCCESS
+///         \li \ref FADA_ERROR_WOULD_ALLOCATE
+/// 
+/// \see fada_bindringstream
+/// \see fada_setwindowframes
+/// \see fada_setffttype
+FADA_API fada_Error fada_bindrealtimestream(fada_Manager* m, fada_TSample sample_type, unsigned int sample_rate, unsigned int channels, fada_Pos capacity_frames, fada_Pos max_window_frames, fada_Pos max_fft_size);
+
+//////////////////////////////////////////////////
+/// \brief Bind a WAV file to the manager without reading it into memory.
+/// 
+/// The file is mapped into memory and its samples are bound as one chunk, as if passed to \ref fada_bindsamples without copying.
+/// Parts of the file are only read from disk once the analysis window reaches them, and parts the window has left behind are released again,
+/// so even files far larger than the available memory can be analyzed. The file stays open until the manager is bound again, cleared with
+/// \ref fada_freechunks, or closed.
+/// 
+/// The sample type, sample rate and channel count are taken from the file. Unsigned 8-bit, 16, 24, 32 and 64-bit integer and 32 and 64-bit floating-point samples are supported.
+/// 
+/// \param m The manager to bind.
+/// \param path Path of the WAV file.
+/// 
+/// \return Returns one of the following error signals:
+///         \li \ref FADA_ERROR_CANNOT_OPEN_FILE
+///         \li \ref FADA_ERROR_INVALID_CHANNEL
+///         \li \ref FADA_ERROR_INVALID_FILE
+///         \li \ref FADA_ERROR_INVALID_PARAMETER
+///         \li \ref FADA_ERROR_INVALID_SAMPLE_RATE
+///         \li \ref FADA_ERROR_INVALID_SIZE
+///         \li \ref FADA_ERROR_INVALID_TYPE
+///         \li \ref FADA_ERROR_NOT_ENOUGH_MEMORY
+///         \li \ref FADA_ERROR_SUCCESS
+///         \li \ref FADA_ERROR_WOULD_ALLOCATE
+/// 
+/// \see fada_bindrawfile
+/// \see fada_bindsamples
+FADA_API fada_Error fada_bindfile(fada_Manager* m, const char* path);
+
+//////////////////////////////////////////////////
+/// \brief Bind a file of headerless PCM samples to the manager without reading it into memory.
+/// 
+/// Same as \ref fada_bindfile, except the audio information is passed in rather than read from a header.
+/// A trailing partial frame at the end of the file is ignored.
+/// 
+/// \param m The manager to bind.
+/// \param path Path of the file.
+/// \param offset Number of bytes to skip at the start of the file.
+/// \param sample_type The sample type of audio data.
+/// \param sample_rate The sample rate of the audio data in Hertz. For example, \c 44100.
+/// \param channels The number of audio channels. For example, \c 1 would be mono audio, \c 2 would be stereo audio, etc.
+/// 
+/// \return Returns one of the following error signals:
+///         \li \ref FADA_ERROR_CANNOT_OPEN_FILE
+///         \li \ref FADA_ERROR_INVALID_CHANNEL
+///         \li \ref FADA_ERROR_INVALID_PARAMETER
+///         \li \ref FADA_ERROR_INVALID_SAMPLE_RATE
+///         \li \ref FADA_ERROR_INVALID_SIZE
+///         \li \ref FADA_ERROR_INVALID_TYPE
+///         \li \ref FADA_ERROR_NOT_ENOUGH_MEMORY
+///         \li \ref FADA_ERROR_SUCCESS
+///         \li \ref FADA_ERROR_WOULD_ALLOCATE
+/// 
+/// \see fada_bindfile
+FADA_API fada_Error fada_bindrawfile(fada_Manager* m, const char* path, fada_Pos offset, fada_TSample sample_type, unsigned int sample_rate, unsigned int channels);
+
+//////////////////////////////////////////////////
+/// \brief Bind a reader of WAV input to the manager as a stream.
+/// 
+/// The WAV header is read from the reader right away, and the manager is bound as with \ref fada_bindstream using the audio information from the header.
+/// The samples are then pushed to the manager in blocks with \ref fada_readblock. If the reader was created with read-ahead, its helper thread starts
+/// reading the first blocks now. A reader can only be bound once.
+/// 
+/// The sample type, sample rate and channel count are taken from the header. Unsigned 8-bit, 16, 24, 32 and 64-bit integer and 32 and 64-bit floating-point samples are supported.
+/// 
+/// \param m The manager to bind.
+/// \param r The reader to take samples from.
+/// 
+/// \return Returns one of the following error signals:
+///         \li \ref FADA_ERROR_INVALID_CHANNEL
+///         \li \ref FADA_ERROR_INVALID_FILE
+///         \li \ref FADA_ERROR_INVALID_PARAMETER
+///         \li \ref FADA_ERROR_INVALID_SAMPLE_RATE
+///         \li \ref FADA_ERROR_INVALID_TYPE
+///         \li \ref FADA_ERROR_NOT_ENOUGH_MEMORY
+///         \li \ref FADA_ERROR_SUCCESS
+///         \li \ref FADA_ERROR_WOULD_ALLOCATE
+/// 
+/// \see fada_bindrawreader
+/// \see fada_newreader
+/// \see fada_readblock
+FADA_API fada_Error fada_bindreader(fada_Manager* m, fada_Reader* r);
+
+//////////////////////////////////////////////////
+/// \brief Bind a reader of headerless PCM input to the manager as a stream.
+/// 
+/// Same as \ref fada_bindreader, except the audio information is passed in rather than read from a header.
+/// 
+/// \param m The manager to bind.
+/// \param r The reader to take samples from.
+/// \param sample_type The sample type of audio data.
+/// \param sample_rate The sample rate of the audio data in Hertz. For example, \c 44100.
+/// \param channels The number of audio channels. For example, \c 1 would be mono audio, \c 2 would be stereo audio, etc.
+/// 
+/// \return Returns one of the following error signals:
+///         \li \ref FADA_ERROR_INVALID_CHANNEL
+///         \li \ref FADA_ERROR_INVALID_PARAMETER
+///         \li \ref FADA_ERROR_INVALID_SAMPLE_RATE
+///         \li \ref FADA_ERROR_INVALID_TYPE
+///         \li \ref FADA_ERROR_NOT_ENOUGH_MEMORY
+///         \li \ref FADA_ERROR_SUCCESS
+///         \li \ref FADA_ERROR_WOULD_ALLOCATE
+/// 
+/// \see fada_bindreader
+FADA_API fada_Error fada_bindrawreader(fada_Manager* m, fada_Reader* r, fada_TSample sample_type, unsigned int sample_rate, unsigned int channels);
+
 //////////////////////////////////////////////////
 /// \brief Push a new chunk of samples to the end of the audio manager.
 /// 
@@ -117,9 +315,10 @@ FADA_API fada_Error fada_bindstream(fada_Manager* m, fada_TSample sample_type, u
 /// \param m The manager to give samples.
 /// \param data Pointer to the audio data.
 /// \param sample_count The number of samples stored in data.
-/// \param copy_data Copy the data being bound to the manager. Set to \ref FADA_FALSE to reference the data instead.
+/// \param copy_data Copy the data being bound to the manager. Set to \ref FADA_FALSE to reference the data instead. Ignored if the manager was bound with \ref fada_bindringstream, which always copies.
 /// 
 /// \return Returns one of the following error signals:
+///         \li \ref FADA_ERROR_BUFFER_FULL
 ///         \li \ref FADA_ERROR_INVALID_SIZE
 ///         \li \ref FADA_ERROR_INVALID_TYPE
 ///         \li \ref FADA_ERROR_MANAGER_NOT_READY
@@ -132,14 +331,41 @@ FADA_API fada_Error fada_bindstream(fada_Manager* m, fada_TSample sample_type, u
 /// \see fada_bindstream
 FADA_API fada_Error fada_pushsamples(fada_Manager* m, void* data, fada_Pos sample_count, fada_Boolean copy_data);
 
+//////////////////////////////////////////////////
+/// \brief Push the next block of samples from a reader to the end of the audio manager.
+/// 
+/// Each block is copied to the manager as with \ref fada_pushsamples. A trailing partial frame at the end of the input is ignored.
+/// If the push fails, the block is kept and pushed again by the next call, so no samples are lost when a ring buffer is full.
+/// 
+/// Streams grow with every block, so either trim them with \ref fada_trimchunks or set a retention limit with \ref fada_setretention.
+/// Blocks are only recycled by the manager's pool if it can hold them; see \ref fada_setpoolsize.
+/// 
+/// \param m The manager to give samples.
+/// \param r The reader bound to the manager with \ref fada_bindreader or \ref fada_bindrawreader.
+/// 
+/// \return Returns one of the following error signals:
+///         \li \ref FADA_ERROR_BUFFER_FULL
+///         \li \ref FADA_ERROR_END_OF_FILE
+///         \li \ref FADA_ERROR_INVALID_PARAMETER
+///         \li \ref FADA_ERROR_INVALID_TYPE
+///         \li \ref FADA_ERROR_MANAGER_NOT_READY
+///         \li \ref FADA_ERROR_NOT_ENOUGH_MEMORY
+///         \li \ref FADA_ERROR_SUCCESS
+/// 
+/// \see fada_bindreader
+/// \see fada_pushsamples
+FADA_API fada_Error fada_readblock(fada_Manager* m, fada_Reader* r);
+
 //////////////////////////////////////////////////
 /// \brief Free audio chunk data before the current "in-use" chunk from the manager.
 /// 
 /// This will make the current chunk become the "first" chunk.
+/// If the manager was bound with \ref fada_bindringstream, all samples before the current position are released instead.
 /// 
 /// \param m The manager to trim.
 /// 
 /// \see fada_freechunks
+/// \see fada_setretention
 FADA_API void fada_trimchunks(fada_Manager* m);
 
 //////////////////////////////////////////////////
@@ -150,6 +376,67 @@ FADA_API void fada_trimchunks(fada_Manager* m);
 /// \see fada_trimchunks
 FADA_API void fada_freechunks(fada_Manager* m);
 
+//////////////////////////////////////////////////
+/// \brief Limit how much audio the manager keeps behind the analysis window, releasing older samples automatically.
+/// 
+/// With a limit set, \ref fada_continue and \ref fada_pushsamples trim the manager as \ref fada_trimchunks would,
+/// but keep the last \p frames frames before the current position so the window can still be moved back over them with \ref fada_setposition.
+/// Chunks are only released whole, so up to one extra chunk may be kept. A manager bound with \ref fada_bindringstream releases exactly up to the limit,
+/// and only from \ref fada_continue, since pushing happens on another thread.
+/// Positions are relative to the first held sample, so they are shifted back by the amount released, as with \ref fada_trimchunks.
+/// Default is \ref FADA_RETAIN_ALL, which never releases samples on its own. The limit is kept when binding the manager again.
+/// 
+/// \param m The manager.
+/// \param frames The number of frames to keep behind the current position, or \ref FADA_RETAIN_ALL.
+/// 
+/// \return Returns one of the following error signals:
+///         \li \ref FADA_ERROR_INVALID_MANAGER
+///         \li \ref FADA_ERROR_SUCCESS
+/// 
+/// \see fada_setretentionseconds
+/// \see fada_trimchunks
+FADA_API fada_Error fada_setretention(fada_Manager* m, fada_Pos frames);
+
+//////////////////////////////////////////////////
+/// \brief Limit how much audio the manager keeps behind the analysis window, in seconds.
+/// 
+/// Same as \ref fada_setretention, converting \p seconds to frames with the bound sample rate.
+/// 
+/// \param m The manager.
+/// \param seconds The duration to keep behind the current position.
+/// 
+/// \return Returns one of the following error signals:
+///         \li \ref FADA_ERROR_INVALID_SIZE
+///         \li \ref FADA_ERROR_MANAGER_NOT_READY
+///         \li \ref FADA_ERROR_SUCCESS
+/// 
+/// \see fada_setretention
+FADA_API fada_Error fada_setretentionseconds(fada_Manager* m, fada_Res seconds);
+
+//////////////////////////////////////////////////
+/// \brief Convert integer samples to normalized floating point once as they are pushed, rather than on every analysis call.
+/// 
+/// With a cache type set, binding the manager to integer samples makes it store them as \p cache_type instead.
+/// \ref fada_pushsamples and \ref fada_bindsamples then convert and normalize every sample once, always keeping a copy even if not asked to,
+/// and all analysis runs on the floating-point samples. This pays off when windows overlap, as each sample is otherwise converted again by every window it is part of.
+/// Converted samples take up more memory than 8 and 16-bit integer samples, and a file bound with \ref fada_bindfile is read into memory as a whole.
+/// Pick the cache type matching the FFT type set with \ref fada_setffttype, so FFT input is not converted between precisions on every window.
+/// 
+/// Results are returned normalized, so \ref fada_getnormalizer returns \c 1, while \ref fada_getsampletype still returns the type of the samples pushed.
+/// Floating-point samples are never converted. The cache type takes effect the next time the manager is bound.
+/// 
+/// \param m The manager.
+/// \param cache_type \ref FADA_TSAMPLE_FLOAT32 or \ref FADA_TSAMPLE_FLOAT64 to convert to, or \ref FADA_TSAMPLE_NOTSET to keep samples as pushed, which is the default.
+/// 
+/// \return Returns one of the following error signals:
+///         \li \ref FADA_ERROR_INVALID_MANAGER
+///         \li \ref FADA_ERROR_INVALID_TYPE
+///         \li \ref FADA_ERROR_SUCCESS
+/// 
+/// \see fada_getnormalizer
+/// \see fada_pushsamples
+FADA_API fada_Error fada_setsamplecache(fada_Manager* m, fada_TSample cache_type);
+
 //////////////////////////////////////////////////
 /// \brief Retrieve the sample type bound to the manager.
 /// 
@@ -172,7 +459,7 @@ FADA_API unsigned int fada_getsamplerate(const fada_Manager* m);
 /// \param m The manager.
 /// 
 /// \return Returns sample count.
-FADA_API unsigned int fada_getsamplecount(const fada_Manager* m);
+FADA_API fada_Pos fada_getsamplecount(const fada_Manager* m);
 
 //////////////////////////////////////////////////
 /// \brief Retrieve the total number of frames bound to the manager.
@@ -182,7 +469,7 @@ FADA_API unsigned int fada_getsamplecount(const fada_Manager* m);
 /// \param m The manager.
 /// 
 /// \return Returns frame count.
-FADA_API unsigned int fada_getframecount(const fada_Manager* m);
+FADA_API fada_Pos fada_getframecount(const fada_Manager* m);
 
 //////////////////////////////////////////////////
 /// \brief Retrieve the number of audio channels bound to the manager.
@@ -253,6 +540,7 @@ FADA_API fada_Error fada_setposition(fada_Manager* m, fada_Pos pos);
 ///         \li \ref FADA_ERROR_MANAGER_NOT_READY
 ///         \li \ref FADA_ERROR_NOT_ENOUGH_MEMORY
 ///         \li \ref FADA_ERROR_SUCCESS
+///         \li \ref FADA_ERROR_WOULD_ALLOCATE
 /// 
 /// \see fada_getwindowsize
 /// \see fada_getwindowframes
@@ -310,6 +598,7 @@ FADA_API fada_Res fada_getnormalizer(const fada_Manager* m);
 /// If the manager doesn't have an FFT buffer already assigned to it, this function is automatically called when an FFT buffer is needed.
 /// You can manually call this function to use the internal FFT buffer during application initialization, so libfada won't need to call this automatically.
 /// Internal FFT buffer size will be the frame count of the manager's analysis window. If the window's frame count is not a power of 2, it will use the closest power of 2 less than the window's frame count.
+/// This also preloads the FFT plan of the buffer in use. See \ref fada_preloadfftplan.
 /// 
 /// \note It is important to remember that this function will not work as intended if an FFT buffer is still assigned to the manager (via \ref fada_usefftbuffer). You must unassign the buffer first: <tt>\ref fada_usefftbuffer (m, NULL)</tt>
 /// 
@@ -319,6 +608,7 @@ FADA_API fada_Res fada_getnormalizer(const fada_Manager* m);
 ///         \li \ref FADA_ERROR_MANAGER_NOT_READY
 ///         \li \ref FADA_ERROR_NOT_ENOUGH_MEMORY
 ///         \li \ref FADA_ERROR_SUCCESS
+///         \li \ref FADA_ERROR_WOULD_ALLOCATE
 /// 
 /// \see fada_usefftbuffer
 FADA_API fada_Error fada_preloadfftbuffer(fada_Manager* m);
@@ -334,15 +624,36 @@ FADA_API fada_Error fada_preloadfftbuffer(fada_Manager* m);
 /// \return Returns one of the following error signals:
 ///         \li \ref FADA_ERROR_MANAGER_NOT_READY
 ///         \li \ref FADA_ERROR_SUCCESS
+///         \li \ref FADA_ERROR_WOULD_ALLOCATE
 /// 
 /// \see fada_newfftbuffer
 /// \see fada_preloadfftbuffer
 FADA_API fada_Error fada_usefftbuffer(fada_Manager* m, fada_FFTBuffer* b);
 
+//////////////////////////////////////////////////
+/// \brief Set the precision of the manager's internal FFT buffer.
+/// 
+/// Default is \ref FADA_TSAMPLE_FLOAT64. With \ref FADA_TSAMPLE_FLOAT32, window conversion, the FFT and magnitude extraction all run in single precision,
+/// which halves the memory used by the FFT and doubles the number of values processed per SIMD instruction. This is usually plenty for visualization.
+/// If an internal FFT buffer of another precision exists, it is closed and recreated when next needed. External buffers keep the precision they were created with.
+/// 
+/// \param m The manager.
+/// \param type Either \ref FADA_TSAMPLE_FLOAT32 or \ref FADA_TSAMPLE_FLOAT64.
+/// 
+/// \return Returns one of the following error signals:
+///         \li \ref FADA_ERROR_INVALID_TYPE
+///         \li \ref FADA_ERROR_SUCCESS
+///         \li \ref FADA_ERROR_WOULD_ALLOCATE
+/// 
+/// \see fada_newfftbuffer32
+/// \see fada_preloadfftbuffer
+FADA_API fada_Error fada_setffttype(fada_Manager* m, fada_TSample type);
+
 //////////////////////////////////////////////////
 /// \brief Retrieve the raw FFT data from the FFT buffer in use.
 /// 
 /// Returned FFT data is an array of fada_Res, with a length of <tt>\ref fada_getfftsize * 2</tt>.
+/// Returns NULL if the FFT buffer in use is single precision, see \ref fada_getfft32.
 /// 
 /// \param m The manager.
 /// 
@@ -355,6 +666,20 @@ FADA_API fada_Error fada_usefftbuffer(fada_Manager* m, fada_FFTBuffer* b);
 /// \see fada_getfftvaluefromfrequency
 FADA_API const fada_Res* fada_getfft(const fada_Manager* m);
 
+//////////////////////////////////////////////////
+/// \brief Retrieve the raw single-precision FFT data from the FFT buffer in use.
+/// 
+/// Returned FFT data is an array of float, with a length of <tt>\ref fada_getfftsize * 2</tt>.
+/// Returns NULL if the FFT buffer in use is double precision, see \ref fada_getfft.
+/// 
+/// \param m The manager.
+/// 
+/// \return Returns array with raw FFT data.
+/// 
+/// \see fada_getfft
+/// \see fada_setffttype
+FADA_API const float* fada_getfft32(const fada_Manager* m);
+
 //////////////////////////////////////////////////
 /// \brief Retrieve the size of the FFT buffer in use.
 /// 
@@ -489,6 +814,20 @@ FADA_API fada_Error fada_getfftvaluefromfrequency(const fada_Manager* m, fada_Re
 /// \see fada_closefftbuffer
 FADA_API fada_FFTBuffer* fada_newfftbuffer(fada_Pos size_po2);
 
+//////////////////////////////////////////////////
+/// \brief Create a new external single-precision buffer.
+/// 
+/// Same as \ref fada_newfftbuffer, except the FFT is calculated and stored as \c float, allocating <tt>sizeof(float) * size_po2 * 2</tt> of memory.
+/// Values retrieved from the buffer are still returned as \ref fada_Res.
+/// 
+/// \param size_po2 The size of the new FFT buffer.
+/// 
+/// \return Returns a new FFT buffer.
+/// 
+/// \see fada_newfftbuffer
+/// \see fada_getfft32_buffer
+FADA_API fada_FFTBuffer* fada_newfftbuffer32(fada_Pos size_po2);
+
 //////////////////////////////////////////////////
 /// \brief Close an existing FFT buffer, freeing its resources.
 /// 
@@ -504,6 +843,7 @@ FADA_API void fada_closefftbuffer(fada_FFTBuffer* b);
 /// \brief Retrieve the raw FFT data from the FFT buffer.
 /// 
 /// Returned FFT data is an array of \ref fada_Res, with a length of <tt>\ref fada_getfftsize_buffer * 2</tt>.
+/// Returns NULL if the buffer was created with \ref fada_newfftbuffer32.
 /// 
 /// \param b The FFT buffer.
 /// 
@@ -515,6 +855,27 @@ FADA_API void fada_closefftbuffer(fada_FFTBuffer* b);
 /// \see fada_getfftvaluesrange_buffer
 FADA_API const fada_Res* fada_getfft_buffer(const fada_FFTBuffer* b);
 
+//////////////////////////////////////////////////
+/// \brief Retrieve the raw single-precision FFT data from the FFT buffer.
+/// 
+/// Returned FFT data is an array of float, with a length of <tt>\ref fada_getfftsize_buffer * 2</tt>.
+/// Returns NULL if the buffer was not created with \ref fada_newfftbuffer32.
+/// 
+/// \param b The FFT buffer.
+/// 
+/// \return Returns array with raw FFT data.
+/// 
+/// \see fada_getfft_buffer
+FADA_API const float* fada_getfft32_buffer(const fada_FFTBuffer* b);
+
+//////////////////////////////////////////////////
+/// \brief Retrieve the precision of the FFT buffer.
+/// 
+/// \param b The FFT buffer.
+/// 
+/// \return Returns \ref FADA_TSAMPLE_FLOAT32 or \ref FADA_TSAMPLE_FLOAT64.
+FADA_API fada_TSample fada_getffttype_buffer(const fada_FFTBuffer* b);
+
 //////////////////////////////////////////////////
 /// \brief Retrieve the size of the FFT buffer.
 /// 
@@ -597,6 +958,130 @@ FADA_API fada_Error fada_getfftvalues_buffer(const fada_FFTBuffer* b, fada_Res*
 /// \see fada_calcfft_channel
 FADA_API fada_Error fada_getfftvaluesrange_buffer(const fada_FFTBuffer* b, fada_Res* out_results, fada_Pos offset, fada_Pos len);
 
+//////////////////////////////////////////////////
+/// \brief Preallocate and use the internal FFT plan of an FFT buffer.
+/// 
+/// If the buffer doesn't have an FFT plan already assigned to it, this function is automatically called when an FFT is calculated on it.
+/// Internal FFT plan size will be the size of the FFT buffer.
+/// 
+/// \param b The FFT buffer.
+/// 
+/// \return Returns one of the following error signals:
+///         \li \ref FADA_ERROR_INVALID_FFT_BUFFER
+///         \li \ref FADA_ERROR_NOT_ENOUGH_MEMORY
+///         \li \ref FADA_ERROR_SUCCESS
+/// 
+/// \see fada_usefftplan
+FADA_API fada_Error fada_preloadfftplan(fada_FFTBuffer* b);
+
+//////////////////////////////////////////////////
+/// \brief Assign an external FFT plan to the FFT buffer.
+/// 
+/// A single plan may be shared by any number of FFT buffers of the same size, including buffers used by managers on other threads.
+/// If \c p is \c NULL, it will unassign an FFT plan, and the buffer will create its own internal plan when needed. See \ref fada_preloadfftplan.
+/// 
+/// \param b The FFT buffer.
+/// \param p The FFT plan to use. Must be the same size as the FFT buffer.
+/// 
+/// \return Returns one of the following error signals:
+///         \li \ref FADA_ERROR_INVALID_FFT_BUFFER
+///         \li \ref FADA_ERROR_INVALID_SIZE
+///         \li \ref FADA_ERROR_SUCCESS
+/// 
+/// \see fada_newfftplan
+/// \see fada_preloadfftplan
+FADA_API fada_Error fada_usefftplan(fada_FFTBuffer* b, fada_FFTPlan* p);
+
+
+//////////////////////////////////////////////////
+// FFT plans
+//////////////////////////////////////////////////
+
+
+//////////////////////////////////////////////////
+/// \brief Create a new FFT plan.
+/// 
+/// FFT plans hold the twiddle factors and bit-reversal permutation for one FFT size, so they are only computed once rather than on every FFT.
+/// \c size_po2 must be a power of 2. If it is not a power of 2, it will use the closest power of 2 less than \c size_po2.
+/// 
+/// \param size_po2 The size of the new FFT plan.
+/// 
+/// \return Returns a new FFT plan, or NULL if the plan could not be created.
+/// 
+/// \see fada_closefftplan
+/// \see fada_usefftplan
+FADA_API fada_FFTPlan* fada_newfftplan(fada_Pos size_po2);
+
+//////////////////////////////////////////////////
+/// \brief Close an existing FFT plan, freeing its resources.
+/// 
+/// If an FFT buffer is still using the plan, make sure you call <tt>\ref fada_usefftplan (b, NULL or anotherPlan)</tt> to unassign the plan from that buffer.
+/// 
+/// \param p The FFT plan to close.
+/// 
+/// \see fada_newfftplan
+FADA_API void fada_closefftplan(fada_FFTPlan* p);
+
+//////////////////////////////////////////////////
+/// \brief Retrieve the size of the FFT plan.
+/// 
+/// \param p The FFT plan.
+/// 
+/// \return Returns the FFT size the plan was created for.
+FADA_API fada_Pos fada_getfftsize_plan(const fada_FFTPlan* p);
+
+
+//////////////////////////////////////////////////
+// Readers
+//////////////////////////////////////////////////
+
+
+//////////////////////////////////////////////////
+/// \brief Create a new reader taking its input from a callback.
+/// 
+/// Readers feed WAV or raw PCM input to a manager without a separate decoding library. The input is read in large sequential blocks of \c block_frames frames,
+/// which are pushed to the manager with \ref fada_readblock. With \c read_ahead, a helper thread reads the next block while the current one is pushed and analyzed,
+/// so the analysis is not held up waiting for the disk. In that case \c read_func is called from the helper thread.
+/// 
+/// \param read_func Callback reading the input.
+/// \param userdata Passed to every call of \c read_func.
+/// \param block_frames Number of frames in each block, or \c 0 for \ref FADA_DEFAULT_BLOCKFRAMES.
+/// \param read_ahead Set to \ref FADA_TRUE to read the next block on a helper thread.
+/// 
+/// \return Returns a new reader, or NULL if \c read_func was NULL or the reader could not be created.
+/// 
+/// \see fada_bindreader
+/// \see fada_closereader
+/// \see fada_newreader_fd
+FADA_API fada_Reader* fada_newreader(fada_ReadFunc read_func, void* userdata, fada_Pos block_frames, fada_Boolean read_ahead);
+
+//////////////////////////////////////////////////
+/// \brief Create a new reader taking its input from a file descriptor.
+/// 
+/// Same as \ref fada_newreader, except the input is read from \c fd. Files, pipes and sockets all work, as nothing is ever seeked.
+/// The file descriptor is not closed by the reader.
+/// 
+/// \param fd The file descriptor to read.
+/// \param block_frames Number of frames in each block, or \c 0 for \ref FADA_DEFAULT_BLOCKFRAMES.
+/// \param read_ahead Set to \ref FADA_TRUE to read the next block on a helper thread.
+/// 
+/// \return Returns a new reader, or NULL if \c fd was negative or the reader could not be created.
+/// 
+/// \see fada_closereader
+/// \see fada_newreader
+FADA_API fada_Reader* fada_newreader_fd(int fd, fada_Pos block_frames, fada_Boolean read_ahead);
+
+//////////////////////////////////////////////////
+/// \brief Close an existing reader, freeing its resources.
+/// 
+/// Waits for the helper thread to finish its current read if the reader was created with read-ahead.
+/// Samples already pushed to a manager stay valid.
+/// 
+/// \param r The reader to close.
+/// 
+/// \see fada_newreader
+FADA_API void fada_closereader(fada_Reader* r);
+
 
 //////////////////////////////////////////////////
 // Analyzation
@@ -775,6 +1260,7 @@ FADA_API fada_Error fada_calcbass_channel(fada_Manager* m, unsigned int channel,
 ///         \li \ref FADA_ERROR_NOT_ENOUGH_MEMORY
 ///         \li \ref FADA_ERROR_SUCCESS
 ///         \li \ref FADA_ERROR_WINDOW_NOT_CREATED
+///         \li \ref FADA_ERROR_WOULD_ALLOCATE
 /// 
 /// \see fada_calcfft_channel
 FADA_API fada_Error fada_calcfft(fada_Manager* m);
@@ -795,8 +1281,185 @@ FADA_API fada_Error fada_calcfft(fada_Manager* m);
 ///         \li \ref FADA_ERROR_NOT_ENOUGH_MEMORY
 ///         \li \ref FADA_ERROR_SUCCESS
 ///         \li \ref FADA_ERROR_WINDOW_NOT_CREATED
+///         \li \ref FADA_ERROR_WOULD_ALLOCATE
 /// 
 /// \see fada_calcfft
+/// \see fada_calcfft_allchannels
 FADA_API fada_Error fada_calcfft_channel(fada_Manager* m, unsigned int channel);
 
+//////////////////////////////////////////////////
+/// \brief Calculate the Fast Fourier Transform for every channel using the current analysis window.
+/// 
+/// \c buffers must hold one FFT buffer per channel, in channel order. All buffers must have the same size and type.
+/// Each channel's FFT is generated on its buffer, with the same results as assigning the buffer and calling \ref fada_calcfft_channel,
+/// but the analysis window is filled once for all channels, and with up to 16 channels it is deinterleaved into every buffer in a single pass.
+/// The manager's assigned FFT buffer is not used.
+/// 
+/// \param m The manager.
+/// \param buffers Array of \ref fada_getchannels FFT buffers.
+/// 
+/// \return Returns one of the following error signals:
+///         \li \ref FADA_ERROR_INVALID_PARAMETER
+///         \li \ref FADA_ERROR_INVALID_TYPE
+///         \li \ref FADA_ERROR_MANAGER_NOT_READY
+///         \li \ref FADA_ERROR_NOT_ENOUGH_MEMORY
+///         \li \ref FADA_ERROR_SUCCESS
+///         \li \ref FADA_ERROR_WINDOW_NOT_CREATED
+///         \li \ref FADA_ERROR_WOULD_ALLOCATE
+/// 
+/// \see fada_calcfft_channel
+/// \see fada_newfftbuffer
+FADA_API fada_Error fada_calcfft_allchannels(fada_Manager* m, fada_FFTBuffer** buffers);
+
+//////////////////////////////////////////////////
+/// \brief Calculate several features of the current analysis window in a single pass.
+/// 
+/// Channels will be mixed.
+/// Gives the same results as calling \ref fada_calcbeat, \ref fada_calcbass, \ref fada_getframes and \ref fada_calcfft
+/// for the selected features, but reads and converts the window's samples only once.
+/// If \ref FADA_FEATURE_FFT is selected, the FFT is generated on the assigned FFT buffer as with \ref fada_calcfft.
+/// Output parameters for features that are not selected may be NULL.
+/// 
+/// \param m The manager.
+/// \param features The features to calculate. Any combination of \ref FADA_FEATURE_BEAT, \ref FADA_FEATURE_BASS, \ref FADA_FEATURE_FRAMES and \ref FADA_FEATURE_FFT.
+/// \param out_beat Destination to write the beat.
+/// \param out_bass Destination to write the bass.
+/// \param out_frames Destination array to write the frames to. Must be able to hold \ref fada_getwindowframes values.
+/// 
+/// \return Returns one of the following error signals:
+///         \li \ref FADA_ERROR_INVALID_PARAMETER
+///         \li \ref FADA_ERROR_INVALID_TYPE
+///         \li \ref FADA_ERROR_MANAGER_NOT_READY
+///         \li \ref FADA_ERROR_NOT_ENOUGH_MEMORY
+///         \li \ref FADA_ERROR_SUCCESS
+///         \li \ref FADA_ERROR_WINDOW_NOT_CREATED
+///         \li \ref FADA_ERROR_WOULD_ALLOCATE
+/// 
+/// \see fada_calcbeat
+/// \see fada_calcbass
+/// \see fada_getframes
+/// \see fada_calcfft
+FADA_API fada_Error fada_calcfeatures(fada_Manager* m, fada_Feature features, fada_Res* out_beat, fada_Res* out_bass, fada_Res* out_frames);
+
+//////////////////////////////////////////////////
+/// \brief Retrieve the number of analysis windows \ref fada_analyzeall produces for a hop size.
+/// 
+/// \param m The manager.
+/// \param hop_frames The number of frames between the start of consecutive windows.
+/// 
+/// \return Returns the number of windows, or \c 0 if the manager is not ready or \p hop_frames is \c 0.
+/// 
+/// \see fada_analyzeall
+FADA_API fada_Pos fada_getwindowcount(const fada_Manager* m, fada_Pos hop_frames);
+
+//////////////////////////////////////////////////
+/// \brief Analyze all audio bound to the manager in one call.
+/// 
+/// Windows start at the first frame and every \p hop_frames frames after it, as if calling
+/// \ref fada_continue with \p hop_frames until the end of audio. The number of windows is given by \ref fada_getwindowcount.
+/// For every window, the features selected by \p features are written to the matching output array, in window order.
+/// \p out_fft receives \ref fada_getfftsize values per window, laid out one window after another. Call \ref fada_preloadfftbuffer beforehand to learn the FFT size.
+/// Output arrays for features that are not selected may be NULL.
+/// 
+/// The manager's position is restored once done.
+/// 
+/// \param m The manager.
+/// \param hop_frames The number of frames between the start of consecutive windows.
+/// \param features The features to calculate. Any combination of \ref FADA_FEATURE_BEAT, \ref FADA_FEATURE_BASS and \ref FADA_FEATURE_FFT.
+/// \param out_beat Output array for beat values.
+/// \param out_bass Output array for bass values.
+/// \param out_fft Output array for FFT magnitudes.
+/// 
+/// \return Returns one of the following error signals:
+///         \li \ref FADA_ERROR_INVALID_PARAMETER
+///         \li \ref FADA_ERROR_INVALID_SIZE
+///         \li \ref FADA_ERROR_INVALID_TYPE
+///         \li \ref FADA_ERROR_MANAGER_NOT_READY
+///         \li \ref FADA_ERROR_NO_DATA
+///         \li \ref FADA_ERROR_NOT_ENOUGH_MEMORY
+///         \li \ref FADA_ERROR_SUCCESS
+///         \li \ref FADA_ERROR_WINDOW_NOT_CREATED
+///         \li \ref FADA_ERROR_WOULD_ALLOCATE
+/// 
+/// \see fada_getwindowcount
+/// \see fada_analyzeall_threaded
+/// \see fada_calcbeat
+/// \see fada_calcbass
+/// \see fada_calcfft
+FADA_API fada_Error fada_analyzeall(fada_Manager* m, fada_Pos hop_frames, fada_Feature features, fada_Res* out_beat, fada_Res* out_bass, fada_Res* out_fft);
+
+//////////////////////////////////////////////////
+/// \brief Analyze all audio bound to the manager in one call, spread across multiple threads.
+/// 
+/// Produces the same results as \ref fada_analyzeall. The windows are split into contiguous ranges, one per thread,
+/// and each thread analyzes its range with its own copy of the manager's position, window and FFT buffers. The calling thread takes part in the work.
+/// A ring stream may keep being pushed to from another thread while this runs, but only the samples held when the call starts are analyzed.
+/// Other audio bound to the manager must not change while this runs.
+/// 
+/// \param m The manager.
+/// \param hop_frames The number of frames between the start of consecutive windows.
+/// \param features The features to calculate. Any combination of \ref FADA_FEATURE_BEAT, \ref FADA_FEATURE_BASS and \ref FADA_FEATURE_FFT.
+/// \param out_beat Output array for beat values.
+/// \param out_bass Output array for bass values.
+/// \param out_fft Output array for FFT magnitudes.
+/// \param threads The number of threads to use. Set to \c 0 to use one thread per processor.
+/// 
+/// \return Returns one of the following error signals:
+///         \li \ref FADA_ERROR_INVALID_PARAMETER
+///         \li \ref FADA_ERROR_INVALID_SIZE
+///         \li \ref FADA_ERROR_INVALID_TYPE
+///         \li \ref FADA_ERROR_MANAGER_NOT_READY
+///         \li \ref FADA_ERROR_NO_DATA
+///         \li \ref FADA_ERROR_NOT_ENOUGH_MEMORY
+///         \li \ref FADA_ERROR_SUCCESS
+///         \li \ref FADA_ERROR_WINDOW_NOT_CREATED
+///         \li \ref FADA_ERROR_WOULD_ALLOCATE
+/// 
+/// \see fada_analyzeall
+/// \see fada_getwindowcount
+FADA_API fada_Error fada_analyzeall_threaded(fada_Manager* m, fada_Pos hop_frames, fada_Feature features, fada_Res* out_beat, fada_Res* out_bass, fada_Res* out_fft, unsigned int threads);
+
+//////////////////////////////////////////////////
+// Memory Management
+//////////////////////////////////////////////////
+
+
+//////////////////////////////////////////////////
+/// \brief Route all memory libfada allocates through custom callbacks.
+/// 
+/// The allocator is global and applies to every manager, FFT buffer and FFT plan.
+/// It must only be changed while no libfada objects exist, since blocks have to be released by the allocator that created them.
+/// Passing NULL for both callbacks restores the default \c malloc and \c free.
+/// Sample, window and FFT buffers are requested with \ref FADA_ALIGNMENT alignment, which the callbacks must honor.
+/// 
+/// \param alloc_func Callback allocating memory.
+/// \param free_func Callback releasing memory returned by \p alloc_func.
+/// \param userdata Pointer passed through to both callbacks.
+/// 
+/// \return Returns one of the following error signals:
+///         \li \ref FADA_ERROR_INVALID_PARAMETER
+///         \li \ref FADA_ERROR_SUCCESS
+/// 
+/// \see fada_setpoolsize
+FADA_API fada_Error fada_setallocator(fada_AllocFunc alloc_func, fada_FreeFunc free_func, void* userdata);
+
+//////////////////////////////////////////////////
+/// \brief Set how much memory the manager keeps to recycle chunks and copied sample blocks.
+/// 
+/// Chunks released by \ref fada_trimchunks or \ref fada_freechunks are kept in a pool of up to \p bytes bytes,
+/// and later calls to \ref fada_pushsamples reuse them, so a stream pushing blocks of the same size stops allocating once the pool warmed up.
+/// Copied sample blocks that fit the pool are rounded up to a power of two, so blocks of similar sizes share one free list.
+/// The pool holds up to \ref FADA_DEFAULT_POOLSIZE bytes by default. Shrinking it releases the memory it holds above the new size.
+/// 
+/// \param m The manager.
+/// \param bytes The maximum number of bytes kept for reuse. Set to \c 0 to disable the pool.
+/// 
+/// \return Returns one of the following error signals:
+///         \li \ref FADA_ERROR_INVALID_MANAGER
+///         \li \ref FADA_ERROR_SUCCESS
+/// 
+/// \see fada_setallocator
+/// \see fada_trimchunks
+FADA_API fada_Error fada_setpoolsize(fada_Manager* m, fada_Pos bytes);
+
 #endif
\ No newline at end of file
@@ -57,6 +57,14 @@
 /// \brief Minor libfada version number.
 #define FADA_VERSION_MINOR 1
 
+//////////////////////////////////////////////////
+/// \def FADA_ABI_VERSION
+/// \brief Version of the binary interface of libfada.
+/// 
+/// Increased whenever a type or function signature changes in a way that breaks programs built against older headers.
+/// Version 2 made \ref fada_Pos 64-bit. See \ref fada_newmanager.
+#define FADA_ABI_VERSION 2
+
 //////////////////////////////////////////////////
 /// \typedef fada_Boolean
 /// \brief Boolean true/false type used by libfada.
@@ -79,6 +87,19 @@ typedef int fada_TSample;
 #define FADA_TSAMPLE_INT64    4 /**< \brief \c FADA_TSAMPLE: Integer 64-bit sample type. */
 #define FADA_TSAMPLE_FLOAT32  5 /**< \brief \c FADA_TSAMPLE: Floating-point 32-bit sample type. */
 #define FADA_TSAMPLE_FLOAT64  6 /**< \brief \c FADA_TSAMPLE: Floating-point 64-bit sample type. */
+#define FADA_TSAMPLE_INT24    7 /**< \brief \c FADA_TSAMPLE: Integer 24-bit sample type, packed into 3 little-endian bytes. */
+#define FADA_TSAMPLE_UINT8    8 /**< \brief \c FADA_TSAMPLE: Unsigned 8-bit sample type, with silence at 128. */
+
+//////////////////////////////////////////////////
+/// \typedef fada_Feature
+/// \brief Bit mask selecting analysis features.
+/// 
+/// Combines the flags \c FADA_FEATURE_*
+typedef unsigned int fada_Feature;
+#define FADA_FEATURE_BEAT   0x1 /**< \brief \c FADA_FEATURE: Beat, as calculated by fada_calcbeat. */
+#define FADA_FEATURE_BASS   0x2 /**< \brief \c FADA_FEATURE: Bass, as calculated by fada_calcbass. */
+#define FADA_FEATURE_FFT    0x4 /**< \brief \c FADA_FEATURE: FFT magnitudes, as returned by fada_getfftvalues after fada_calcfft. */
+#define FADA_FEATURE_FRAMES 0x8 /**< \brief \c FADA_FEATURE: Frames of the analysis window, as returned by fada_getframes. */
 
 //////////////////////////////////////////////////
 /// \typedef fada_Error
@@ -102,17 +123,68 @@ typedef int fada_Error;
 #define FADA_ERROR_POSITION_OUT_OF_BOUNDS    13 /**< \brief \c FADA_ERROR: Position was out of bounds. */
 #define FADA_ERROR_FREQUENCY_OUT_OF_BOUNDS   14 /**< \brief \c FADA_ERROR: Frequency was out of the valid frequency range. */
 #define FADA_ERROR_WINDOW_NOT_CREATED        15 /**< \brief \c FADA_ERROR: Manager does not have a window buffer created. */
+#define FADA_ERROR_BUFFER_FULL               16 /**< \brief \c FADA_ERROR: Ring buffer does not have room for the pushed samples. */
+#define FADA_ERROR_WOULD_ALLOCATE            17 /**< \brief \c FADA_ERROR: Operation would allocate or release memory on a manager bound with fada_bindrealtimestream. */
+#define FADA_ERROR_CANNOT_OPEN_FILE          18 /**< \brief \c FADA_ERROR: File could not be opened or mapped into memory. */
+#define FADA_ERROR_INVALID_FILE              19 /**< \brief \c FADA_ERROR: File is not a valid WAV file, or is truncated. */
+#define FADA_ERROR_END_OF_FILE               20 /**< \brief \c FADA_ERROR: Reader has no more samples to push. */
 
 //////////////////////////////////////////////////
 /// \typedef fada_Pos
 /// \brief Unsigned integral type used for position and size related values.
-typedef unsigned int fada_Pos;
+/// 
+/// 64-bit, so that streams running for days can be bound and analyzed without positions wrapping around.
+typedef unsigned long long fada_Pos;
+
+//////////////////////////////////////////////////
+/// \def FADA_ALIGNMENT
+/// \brief Alignment in bytes of sample, window and FFT buffers allocated by libfada.
+/// 
+/// Matches the cache line size, so buffers never share a cache line with other data and SIMD loads never straddle one.
+#define FADA_ALIGNMENT 64U
+
+//////////////////////////////////////////////////
+/// \typedef fada_AllocFunc
+/// \brief Memory allocation callback, as installed with fada_setallocator.
+/// 
+/// Must return a block of at least \c size bytes aligned to \c alignment bytes, or NULL on failure.
+/// \c alignment is always a power of two, at least <tt>2 * sizeof(void*)</tt>, and at most \ref FADA_ALIGNMENT.
+typedef void* (*fada_AllocFunc)(fada_Pos size, fada_Pos alignment, void* userdata);
+
+//////////////////////////////////////////////////
+/// \typedef fada_FreeFunc
+/// \brief Memory release callback, as installed with fada_setallocator.
+/// 
+/// Only ever called with blocks returned by the matching \ref fada_AllocFunc, never with NULL.
+typedef void (*fada_FreeFunc)(void* ptr, void* userdata);
+
+//////////////////////////////////////////////////
+/// \typedef fada_ReadFunc
+/// \brief Input callback of a reader, as created with fada_newreader.
+/// 
+/// Must copy up to \c size bytes of the input into \c buffer and return the number of bytes copied.
+/// Returning fewer bytes than requested is fine; returning 0 ends the input.
+typedef fada_Pos (*fada_ReadFunc)(void* buffer, fada_Pos size, void* userdata);
 
 //////////////////////////////////////////////////
 /// \def FADA_DEFAULT_WINDOWSIZE
 /// \brief Default analysis window size used if no window size was set.
 #define FADA_DEFAULT_WINDOWSIZE 1024U
 
+//////////////////////////////////////////////////
+/// \def FADA_DEFAULT_POOLSIZE
+/// \brief Default number of bytes a manager keeps for reuse after trimming chunks.
+/// 
+/// \see fada_setpoolsize
+#define FADA_DEFAULT_POOLSIZE 262144U
+
+//////////////////////////////////////////////////
+/// \def FADA_DEFAULT_BLOCKFRAMES
+/// \brief Default number of frames a reader pushes to the manager at a time.
+/// 
+/// \see fada_newreader
+#define FADA_DEFAULT_BLOCKFRAMES 65536U
+
 //////////////////////////////////////////////////
 /// \def FADA_NEXT_WINDOW
 /// \brief Used in fada_continue to instruct libfada to advance to the next window.
@@ -123,6 +195,13 @@ typedef unsigned int fada_Pos;
 /// \see fada_continue
 #define FADA_NEXT_WINDOW -1L
 
+//////////////////////////////////////////////////
+/// \def FADA_RETAIN_ALL
+/// \brief Used in fada_setretention to keep every sample until it is trimmed manually.
+/// 
+/// \see fada_setretention
+#define FADA_RETAIN_ALL ((fada_Pos)-1)
+
 //////////////////////////////////////////////////
 /// \typedef fada_Res
 /// \brief Floating-point result type.
@@ -140,4 +219,14 @@ typedef struct fada_Manager fada_Manager;
 /// \brief Stores generated FFT data.
 typedef struct fada_FFTBuffer fada_FFTBuffer;
 
+//////////////////////////////////////////////////
+/// \typedef fada_FFTPlan
+/// \brief Stores precomputed twiddle factors and bit-reversal tables for an FFT size.
+typedef struct fada_FFTPlan fada_FFTPlan;
+
+//////////////////////////////////////////////////
+/// \typedef fada_Reader
+/// \brief Reads WAV or raw PCM input in blocks and pushes it to a manager.
+typedef struct fada_Reader fada_Reader;
+
 #endif
\ No newline at end of file
@@ -26,6 +26,9 @@
 #include <fada/fada.h>
 #include "fada_calc.h"
 #include "fada_manager.h"
+#include "fada_fftbuffer.h"
+#include "fada_mem.h"
+#include "fada_thread.h"
 
 
 //////////////////////////////////////////////////
@@ -40,6 +43,8 @@ FADA_API fada_Error fada_getsample(fada_Manager* m, fada_Pos pos, unsigned int c
 	if (channel >= m->channels)
 		return FADA_ERROR_INVALID_CHANNEL;
 
+	fada_syncring(m);
+
 	if (!m->current_chunk)
 	{
 		(*out_result) = 0.;
@@ -48,16 +53,10 @@ FADA_API fada_Error fada_getsample(fada_Manager* m, fada_Pos pos, unsigned int c
 
 	pos *= m->channels;
 
-	switch (m->sample_type)
-	{
-		case FADA_TSAMPLE_INT8:    (*out_result) = fada_getsample_i8(m, pos + channel);  break;
-		case FADA_TSAMPLE_INT16:   (*out_result) = fada_getsample_i16(m, pos + channel); break;
-		case FADA_TSAMPLE_INT32:   (*out_result) = fada_getsample_i32(m, pos + channel); break;
-		case FADA_TSAMPLE_INT64:   (*out_result) = fada_getsample_i64(m, pos + channel); break;
-		case FADA_TSAMPLE_FLOAT32: (*out_result) = fada_getsample_f32(m, pos + channel); break;
-		case FADA_TSAMPLE_FLOAT64: (*out_result) = fada_getsample_f64(m, pos + channel); break;
-		default: return FADA_ERROR_INVALID_TYPE;
-	}
+	if (!m->kernels)
+		return FADA_ERROR_INVALID_TYPE;
+
+	(*out_result) = m->kernels->getsample(m, pos + channel);
 
 	return FADA_ERROR_SUCCESS;
 }
@@ -75,22 +74,18 @@ FADA_API fada_Error fada_getsamples(fada_Manager* m, unsigned int channel, fada_
 	if (channel >= m->channels)
 		return FADA_ERROR_INVALID_CHANNEL;
 
+	fada_syncring(m);
+
 	if (!m->current_chunk)
 	{
 		(*out_results) = 0.;
 		return FADA_ERROR_SUCCESS;
 	}
 	
-	switch (m->sample_type)
-	{
-		case FADA_TSAMPLE_INT8:    fada_getsamples_i8(m, channel, out_results);  break;
-		case FADA_TSAMPLE_INT16:   fada_getsamples_i16(m, channel, out_results); break;
-		case FADA_TSAMPLE_INT32:   fada_getsamples_i32(m, channel, out_results); break;
-		case FADA_TSAMPLE_INT64:   fada_getsamples_i64(m, channel, out_results); break;
-		case FADA_TSAMPLE_FLOAT32: fada_getsamples_f32(m, channel, out_results); break;
-		case FADA_TSAMPLE_FLOAT64: fada_getsamples_f64(m, channel, out_results); break;
-		default: return FADA_ERROR_INVALID_TYPE;
-	}
+	if (!m->kernels)
+		return FADA_ERROR_INVALID_TYPE;
+
+	m->kernels->getsamples(m, channel, out_results);
 
 	return FADA_ERROR_SUCCESS;
 }
@@ -105,6 +100,8 @@ FADA_API fada_Error fada_getframe(fada_Manager* m, fada_Pos pos, fada_Res* out_r
 	if (!m->window.buffer)
 		return FADA_ERROR_WINDOW_NOT_CREATED;
 
+	fada_syncring(m);
+
 	if (!m->current_chunk)
 	{
 		(*out_result) = 0.;
@@ -113,16 +110,10 @@ FADA_API fada_Error fada_getframe(fada_Manager* m, fada_Pos pos, fada_Res* out_r
 
 	pos *= m->channels;
 
-	switch (m->sample_type)
-	{
-		case FADA_TSAMPLE_INT8:    (*out_result) = fada_getframe_i8(m, pos);  break;
-		case FADA_TSAMPLE_INT16:   (*out_result) = fada_getframe_i16(m, pos); break;
-		case FADA_TSAMPLE_INT32:   (*out_result) = fada_getframe_i32(m, pos); break;
-		case FADA_TSAMPLE_INT64:   (*out_result) = fada_getframe_i64(m, pos); break;
-		case FADA_TSAMPLE_FLOAT32: (*out_result) = fada_getframe_f32(m, pos); break;
-		case FADA_TSAMPLE_FLOAT64: (*out_result) = fada_getframe_f64(m, pos); break;
-		default: return FADA_ERROR_INVALID_TYPE;
-	}
+	if (!m->kernels)
+		return FADA_ERROR_INVALID_TYPE;
+
+	(*out_result) = m->kernels->getframe(m, pos);
 
 	return FADA_ERROR_SUCCESS;
 }
@@ -137,22 +128,18 @@ FADA_API fada_Error fada_getframes(fada_Manager* m, fada_Res* out_results)
 	if (!m->window.buffer)
 		return FADA_ERROR_WINDOW_NOT_CREATED;
 
+	fada_syncring(m);
+
 	if (!m->current_chunk)
 	{
 		(*out_results) = 0.;
 		return FADA_ERROR_SUCCESS;
 	}
 	
-	switch (m->sample_type)
-	{
-		case FADA_TSAMPLE_INT8:    fada_getframes_i8(m, out_results);  break;
-		case FADA_TSAMPLE_INT16:   fada_getframes_i16(m, out_results); break;
-		case FADA_TSAMPLE_INT32:   fada_getframes_i32(m, out_results); break;
-		case FADA_TSAMPLE_INT64:   fada_getframes_i64(m, out_results); break;
-		case FADA_TSAMPLE_FLOAT32: fada_getframes_f32(m, out_results); break;
-		case FADA_TSAMPLE_FLOAT64: fada_getframes_f64(m, out_results); break;
-		default: return FADA_ERROR_INVALID_TYPE;
-	}
+	if (!m->kernels)
+		return FADA_ERROR_INVALID_TYPE;
+
+	m->kernels->getframes(m, out_results);
 
 	return FADA_ERROR_SUCCESS;
 }
@@ -167,22 +154,18 @@ FADA_API fada_Error fada_calcbeat(fada_Manager* m, fada_Res* out_result)
 	if (!m->window.buffer)
 		return FADA_ERROR_WINDOW_NOT_CREATED;
 
+	fada_syncring(m);
+
 	if (!m->current_chunk)
 	{
 		(*out_result) = 0.;
 		return FADA_ERROR_SUCCESS;
 	}
 
-	switch (m->sample_type)
-	{
-		case FADA_TSAMPLE_INT8:    (*out_result) = fada_calcbeat_i8(m);  break;
-		case FADA_TSAMPLE_INT16:   (*out_result) = fada_calcbeat_i16(m); break;
-		case FADA_TSAMPLE_INT32:   (*out_result) = fada_calcbeat_i32(m); break;
-		case FADA_TSAMPLE_INT64:   (*out_result) = fada_calcbeat_i64(m); break;
-		case FADA_TSAMPLE_FLOAT32: (*out_result) = fada_calcbeat_f32(m); break;
-		case FADA_TSAMPLE_FLOAT64: (*out_result) = fada_calcbeat_f64(m); break;
-		default: return FADA_ERROR_INVALID_TYPE;
-	}
+	if (!m->kernels)
+		return FADA_ERROR_INVALID_TYPE;
+
+	(*out_result) = m->kernels->calcbeat(m);
 
 	return FADA_ERROR_SUCCESS;
 }
@@ -200,22 +183,18 @@ FADA_API fada_Error fada_calcbeat_channel(fada_Manager* m, unsigned int channel,
 	if (channel >= m->channels)
 		return FADA_ERROR_INVALID_CHANNEL;
 
+	fada_syncring(m);
+
 	if (!m->current_chunk)
 	{
 		(*out_result) = 0.;
 		return FADA_ERROR_SUCCESS;
 	}
 
-	switch (m->sample_type)
-	{
-		case FADA_TSAMPLE_INT8:    (*out_result) = fada_calcbeat_channel_i8(m, channel);  break;
-		case FADA_TSAMPLE_INT16:   (*out_result) = fada_calcbeat_channel_i16(m, channel); break;
-		case FADA_TSAMPLE_INT32:   (*out_result) = fada_calcbeat_channel_i32(m, channel); break;
-		case FADA_TSAMPLE_INT64:   (*out_result) = fada_calcbeat_channel_i64(m, channel); break;
-		case FADA_TSAMPLE_FLOAT32: (*out_result) = fada_calcbeat_channel_f32(m, channel); break;
-		case FADA_TSAMPLE_FLOAT64: (*out_result) = fada_calcbeat_channel_f64(m, channel); break;
-		default: return FADA_ERROR_INVALID_TYPE;
-	}
+	if (!m->kernels)
+		return FADA_ERROR_INVALID_TYPE;
+
+	(*out_result) = m->kernels->calcbeat_channel(m, channel);
 
 	return FADA_ERROR_SUCCESS;
 }
@@ -230,22 +209,18 @@ FADA_API fada_Error fada_calcbass(fada_Manager* m, fada_Res* out_result)
 	if (!m->window.buffer)
 		return FADA_ERROR_WINDOW_NOT_CREATED;
 
+	fada_syncring(m);
+
 	if (!m->current_chunk)
 	{
 		(*out_result) = 0.;
 		return FADA_ERROR_SUCCESS;
 	}
 
-	switch (m->sample_type)
-	{
-		case FADA_TSAMPLE_INT8:    (*out_result) = fada_calcbass_i8(m);  break;
-		case FADA_TSAMPLE_INT16:   (*out_result) = fada_calcbass_i16(m); break;
-		case FADA_TSAMPLE_INT32:   (*out_result) = fada_calcbass_i32(m); break;
-		case FADA_TSAMPLE_INT64:   (*out_result) = fada_calcbass_i64(m); break;
-		case FADA_TSAMPLE_FLOAT32: (*out_result) = fada_calcbass_f32(m); break;
-		case FADA_TSAMPLE_FLOAT64: (*out_result) = fada_calcbass_f64(m); break;
-		default: return FADA_ERROR_INVALID_TYPE;
-	}
+	if (!m->kernels)
+		return FADA_ERROR_INVALID_TYPE;
+
+	(*out_result) = m->kernels->calcbass(m);
 
 	return FADA_ERROR_SUCCESS;
 }
@@ -263,22 +238,18 @@ FADA_API fada_Error fada_calcbass_channel(fada_Manager* m, unsigned int channel,
 	if (channel >= m->channels)
 		return FADA_ERROR_INVALID_CHANNEL;
 
+	fada_syncring(m);
+
 	if (!m->current_chunk)
 	{
 		(*out_result) = 0.;
 		return FADA_ERROR_SUCCESS;
 	}
 
-	switch (m->sample_type)
-	{
-		case FADA_TSAMPLE_INT8:    (*out_result) = fada_calcbass_channel_i8(m, channel);  break;
-		case FADA_TSAMPLE_INT16:   (*out_result) = fada_calcbass_channel_i16(m, channel); break;
-		case FADA_TSAMPLE_INT32:   (*out_result) = fada_calcbass_channel_i32(m, channel); break;
-		case FADA_TSAMPLE_INT64:   (*out_result) = fada_calcbass_channel_i64(m, channel); break;
-		case FADA_TSAMPLE_FLOAT32: (*out_result) = fada_calcbass_channel_f32(m, channel); break;
-		case FADA_TSAMPLE_FLOAT64: (*out_result) = fada_calcbass_channel_f64(m, channel); break;
-		default: return FADA_ERROR_INVALID_TYPE;
-	}
+	if (!m->kernels)
+		return FADA_ERROR_INVALID_TYPE;
+
+	(*out_result) = m->kernels->calcbass_channel(m, channel);
 
 	return FADA_ERROR_SUCCESS;
 }
@@ -294,19 +265,18 @@ FADA_API fada_Error fada_calcfft(fada_Manager* m)
 	if (!m->window.buffer)
 		return FADA_ERROR_WINDOW_NOT_CREATED;
 
+	fada_syncring(m);
+
 	if (!m->current_chunk)
 		return FADA_ERROR_SUCCESS;
 
-	switch (m->sample_type)
-	{
-		case FADA_TSAMPLE_INT8:    fada_calcfft_i8(m);  break;
-		case FADA_TSAMPLE_INT16:   fada_calcfft_i16(m); break;
-		case FADA_TSAMPLE_INT32:   fada_calcfft_i32(m); break;
-		case FADA_TSAMPLE_INT64:   fada_calcfft_i64(m); break;
-		case FADA_TSAMPLE_FLOAT32: fada_calcfft_f32(m); break;
-		case FADA_TSAMPLE_FLOAT64: fada_calcfft_f64(m); break;
-		default: return FADA_ERROR_INVALID_TYPE;
-	}
+	if (!m->kernels)
+		return FADA_ERROR_INVALID_TYPE;
+
+	if (m->fft.buffer->type == FADA_TSAMPLE_FLOAT32)
+		m->kernels->calcfft32(m);
+	else
+		m->kernels->calcfft(m);
 
 	return FADA_ERROR_SUCCESS;
 }
@@ -327,19 +297,441 @@ FADA_API fada_Error fada_calcfft_channel(fada_Manager* m, unsigned int channel)
 	if (channel >= m->channels)
 		return FADA_ERROR_INVALID_CHANNEL;
 
+	fada_syncring(m);
+
+	if (!m->current_chunk)
+		return FADA_ERROR_SUCCESS;
+
+	if (!m->kernels)
+		return FADA_ERROR_INVALID_TYPE;
+
+	if (m->fft.buffer->type == FADA_TSAMPLE_FLOAT32)
+		m->kernels->calcfft32_channel(m, channel);
+	else
+		m->kernels->calcfft_channel(m, channel);
+
+	return FADA_ERROR_SUCCESS;
+}
+
+
+//////////////////////////////////////////////////
+FADA_API fada_Error fada_calcfft_allchannels(fada_Manager* m, fada_FFTBuffer** buffers)
+{
+	fada_Error err;
+	unsigned int chan;
+
+	if (!m->ready) return FADA_ERROR_MANAGER_NOT_READY;
+
+	if (!buffers)
+		return FADA_ERROR_INVALID_PARAMETER;
+
+	for (chan = 0; chan < m->channels; ++chan)
+	{
+		if (!buffers[chan] || buffers[chan]->size != buffers[0]->size || buffers[chan]->type != buffers[0]->type)
+			return FADA_ERROR_INVALID_PARAMETER;
+
+		// Real-time managers can only use buffers whose plans were loaded up front.
+		if (m->realtime && !buffers[chan]->plan)
+			return FADA_ERROR_WOULD_ALLOCATE;
+
+		err = fada_preloadfftplan(buffers[chan]);
+		if (err != FADA_ERROR_SUCCESS)
+			return err;
+	}
+
+	if (!m->window.buffer)
+		return FADA_ERROR_WINDOW_NOT_CREATED;
+
+	fada_syncring(m);
+
 	if (!m->current_chunk)
 		return FADA_ERROR_SUCCESS;
 
-	switch (m->sample_type)
+	if (!m->kernels)
+		return FADA_ERROR_INVALID_TYPE;
+
+	m->kernels->calcfft_allchannels(m, buffers);
+
+	return FADA_ERROR_SUCCESS;
+}
+
+
+//////////////////////////////////////////////////
+FADA_API fada_Error fada_calcfeatures(fada_Manager* m, fada_Feature features, fada_Res* out_beat, fada_Res* out_bass, fada_Res* out_frames)
+{
+	fada_Error err;
+
+	if ((features & FADA_FEATURE_BEAT) && !out_beat) return FADA_ERROR_INVALID_PARAMETER;
+	if ((features & FADA_FEATURE_BASS) && !out_bass) return FADA_ERROR_INVALID_PARAMETER;
+	if ((features & FADA_FEATURE_FRAMES) && !out_frames) return FADA_ERROR_INVALID_PARAMETER;
+
+	if (features & FADA_FEATURE_FFT)
+	{
+		err = fada_preloadfftbuffer(m);
+		if (err != FADA_ERROR_SUCCESS)
+			return err;
+	}
+
+	if (!m->window.buffer)
+		return FADA_ERROR_WINDOW_NOT_CREATED;
+
+	if (!(features & FADA_FEATURE_BEAT)) out_beat = NULL;
+	if (!(features & FADA_FEATURE_BASS)) out_bass = NULL;
+	if (!(features & FADA_FEATURE_FRAMES)) out_frames = NULL;
+
+	fada_syncring(m);
+
+	if (!m->current_chunk)
 	{
-		case FADA_TSAMPLE_INT8:    fada_calcfft_channel_i8(m, channel);  break;
-		case FADA_TSAMPLE_INT16:   fada_calcfft_channel_i16(m, channel); break;
-		case FADA_TSAMPLE_INT32:   fada_calcfft_channel_i32(m, channel); break;
-		case FADA_TSAMPLE_INT64:   fada_calcfft_channel_i64(m, channel); break;
-		case FADA_TSAMPLE_FLOAT32: fada_calcfft_channel_f32(m, channel); break;
-		case FADA_TSAMPLE_FLOAT64: fada_calcfft_channel_f64(m, channel); break;
-		default: return FADA_ERROR_INVALID_TYPE;
+		if (out_beat)
+			(*out_beat) = 0.;
+		if (out_bass)
+			(*out_bass) = 0.;
+		if (out_frames)
+			fada_memzero(out_frames, (m->window.size / m->channels) * sizeof(fada_Res));
+
+		return FADA_ERROR_SUCCESS;
 	}
 
+	if (!m->kernels)
+		return FADA_ERROR_INVALID_TYPE;
+
+	m->kernels->calcfeatures(m, features, out_beat, out_bass, out_frames);
+
 	return FADA_ERROR_SUCCESS;
+}
+
+
+//////////////////////////////////////////////////
+FADA_API fada_Pos fada_getwindowcount(const fada_Manager* m, fada_Pos hop_frames)
+{
+	if (!m->ready || !hop_frames)
+		return 0;
+
+	// One window per hop, up to and including the last one starting before the end of audio.
+	return (fada_getframecount(m) + hop_frames - 1) / hop_frames;
+}
+
+
+//////////////////////////////////////////////////
+typedef struct fada_AnalyzeJob
+{
+	fada_Manager* m;
+	fada_Pos first;
+	fada_Pos count;
+	fada_Pos hop_frames;
+	fada_Feature features;
+
+	fada_Res* out_beat;
+	fada_Res* out_bass;
+	fada_Res* out_fft;
+} fada_AnalyzeJob;
+
+
+//////////////////////////////////////////////////
+static fada_Error fada_prepareanalyzejob(fada_AnalyzeJob* job, fada_Manager* m, fada_Pos hop_frames, fada_Feature features, fada_Res* out_beat, fada_Res* out_bass, fada_Res* out_fft)
+{
+	fada_Error err;
+
+	if (!m->ready) return FADA_ERROR_MANAGER_NOT_READY;
+	if (!m->window.buffer) return FADA_ERROR_WINDOW_NOT_CREATED;
+	if (!hop_frames) return FADA_ERROR_INVALID_SIZE;
+
+	if ((features & FADA_FEATURE_BEAT) && !out_beat) return FADA_ERROR_INVALID_PARAMETER;
+	if ((features & FADA_FEATURE_BASS) && !out_bass) return FADA_ERROR_INVALID_PARAMETER;
+	if ((features & FADA_FEATURE_FFT) && !out_fft) return FADA_ERROR_INVALID_PARAMETER;
+
+	fada_syncring(m);
+
+	if (!m->current_chunk)
+		return FADA_ERROR_NO_DATA;
+
+	if (features & FADA_FEATURE_FFT)
+	{
+		err = fada_preloadfftbuffer(m);
+		if (err != FADA_ERROR_SUCCESS)
+			return err;
+	}
+
+	if (!m->kernels)
+		return FADA_ERROR_INVALID_TYPE;
+
+	job->m = m;
+	job->first = 0;
+	job->count = fada_getwindowcount(m, hop_frames);
+	job->hop_frames = hop_frames;
+	job->features = features;
+	job->out_beat = out_beat;
+	job->out_bass = out_bass;
+	job->out_fft = out_fft;
+
+	return FADA_ERROR_SUCCESS;
+}
+
+
+//////////////////////////////////////////////////
+static void fada_runanalyzejob(void* arg)
+{
+	fada_AnalyzeJob* job = (fada_AnalyzeJob*)arg;
+	fada_Manager* m = job->m;
+	fada_Pos i, fft_size, retention;
+
+	fft_size = (job->features & FADA_FEATURE_FFT) ? m->fft.buffer->size : 0;
+
+	// The job walks over all samples and returns to where it started, so nothing may be released on the way.
+	retention = m->retention;
+	m->retention = FADA_RETAIN_ALL;
+
+	fada_setposition(m, job->first * job->hop_frames);
+
+	for (i = job->first; i < job->first + job->count; ++i)
+	{
+		if (job->features & FADA_FEATURE_FFT)
+		{
+			// The FFT needs a full pass over the window anyway, so take beat and bass from the same pass.
+			m->kernels->calcfeatures(m, job->features,
+				(job->features & FADA_FEATURE_BEAT) ? &job->out_beat[i] : NULL,
+				(job->features & FADA_FEATURE_BASS) ? &job->out_bass[i] : NULL,
+				NULL);
+
+			fada_getfftvalues_buffer(m->fft.buffer, &job->out_fft[i * fft_size]);
+		}
+		else
+		{
+			if (job->features & FADA_FEATURE_BEAT)
+				job->out_beat[i] = m->kernels->calcbeat(m);
+
+			if (job->features & FADA_FEATURE_BASS)
+				job->out_bass[i] = m->kernels->calcbass(m);
+		}
+
+		fada_continue(m, job->hop_frames);
+	}
+
+	m->retention = retention;
+}
+
+
+//////////////////////////////////////////////////
+FADA_API fada_Error fada_analyzeall(fada_Manager* m, fada_Pos hop_frames, fada_Feature features, fada_Res* out_beat, fada_Res* out_bass, fada_Res* out_fft)
+{
+	fada_AnalyzeJob job;
+	fada_Pos pos;
+	fada_Error err;
+
+	err = fada_prepareanalyzejob(&job, m, hop_frames, features, out_beat, out_bass, out_fft);
+	if (err != FADA_ERROR_SUCCESS)
+		return err;
+
+	pos = fada_getposition(m);
+	fada_runanalyzejob(&job);
+	fada_setposition(m, pos);
+
+	return FADA_ERROR_SUCCESS;
+}
+
+
+//////////////////////////////////////////////////
+typedef struct fada_AnalyzeWorker
+{
+	fada_Manager m;
+	fada_Chunk ring_chunk;
+} fada_AnalyzeWorker;
+
+
+//////////////////////////////////////////////////
+static fada_Error fada_newworkermanager(fada_AnalyzeWorker* worker, const fada_Manager* m, fada_Feature features)
+{
+	fada_Manager* w = &worker->m;
+	fada_Error err;
+
+	// Workers share the manager's chunks, but have their own window and FFT buffers.
+	// The manager isn't copied as a whole, since another thread may be pushing to its ring.
+	w->current_chunk = m->current_chunk;
+	w->first_chunk = m->first_chunk;
+	w->last_chunk = m->last_chunk;
+
+	w->current_sample = m->current_sample;
+	w->sample_count = m->sample_count;
+	w->retention = m->retention;
+	w->sample_type = m->sample_type;
+	w->store_type = m->store_type;
+	w->kernels = m->kernels;
+	w->convert = m->convert;
+
+	w->channels = m->channels;
+	w->sample_rate = m->sample_rate;
+
+	w->window.buffer = NULL;
+	w->window.samples = NULL;
+	w->window.size = 0;
+	w->window.capacity = 0;
+	w->window.shift = 0;
+	w->window.sample_size = 0;
+	w->window.filled = FADA_FALSE;
+	w->window.padded = FADA_FALSE;
+
+	w->sums = m->sums;
+	w->index = m->index;
+
+	w->fft.buffer = NULL;
+	w->fft.internal = FADA_FALSE;
+	w->fft.type = m->fft.type;
+
+	w->cache = m->cache;
+	w->pool = m->pool;
+
+	// Only the manager itself may sync with its ring, or release pages of its mapped file.
+	w->ring.buffer = NULL;
+	w->ring.chunk = NULL;
+	w->ring.capacity = 0;
+	w->ring.read = 0;
+	w->ring.write = 0;
+	w->ring.sample_size = 0;
+	w->file = NULL;
+
+	w->realtime = FADA_FALSE;
+	w->ready = m->ready;
+
+	// The manager keeps resizing its ring chunk as samples are synced, so workers read the synced samples through a copy.
+	if (m->ring.chunk && m->first_chunk == m->ring.chunk)
+	{
+		worker->ring_chunk = *m->ring.chunk;
+		worker->ring_chunk.next = NULL;
+		worker->ring_chunk.prev = NULL;
+
+		w->current_chunk = &worker->ring_chunk;
+		w->first_chunk = &worker->ring_chunk;
+		w->last_chunk = &worker->ring_chunk;
+	}
+
+	err = fada_setwindowframes(w, m->window.size / m->channels);
+	if (err != FADA_ERROR_SUCCESS)
+		return err;
+
+	if (features & FADA_FEATURE_FFT)
+	{
+		if (m->fft.buffer->type == FADA_TSAMPLE_FLOAT32)
+			w->fft.buffer = fada_newfftbuffer32(m->fft.buffer->size);
+		else
+			w->fft.buffer = fada_newfftbuffer(m->fft.buffer->size);
+
+		if (!w->fft.buffer)
+		{
+			fada_memfree(w->window.buffer);
+			return FADA_ERROR_NOT_ENOUGH_MEMORY;
+		}
+
+		w->fft.internal = FADA_TRUE;
+
+		// Share the manager's twiddle tables instead of building them again.
+		fada_usefftplan(w->fft.buffer, m->fft.buffer->plan);
+	}
+
+	return FADA_ERROR_SUCCESS;
+}
+
+
+//////////////////////////////////////////////////
+static void fada_closeworkermanager(fada_AnalyzeWorker* worker)
+{
+	if (worker->m.window.buffer)
+		fada_memfree(worker->m.window.buffer);
+
+	if (worker->m.fft.buffer)
+		fada_closefftbuffer(worker->m.fft.buffer);
+}
+
+
+//////////////////////////////////////////////////
+FADA_API fada_Error fada_analyzeall_threaded(fada_Manager* m, fada_Pos hop_frames, fada_Feature features, fada_Res* out_beat, fada_Res* out_bass, fada_Res* out_fft, unsigned int threads)
+{
+	fada_AnalyzeJob job;
+	fada_AnalyzeJob* jobs;
+	fada_AnalyzeWorker* workers;
+	fada_Thread** handles;
+	fada_Pos pos, first;
+	fada_Error err;
+	unsigned int t, created;
+
+	err = fada_prepareanalyzejob(&job, m, hop_frames, features, out_beat, out_bass, out_fft);
+	if (err != FADA_ERROR_SUCCESS)
+		return err;
+
+	if (!threads)
+		threads = fada_getcpucount();
+
+	if (threads > job.count)
+		threads = job.count;
+
+	if (threads <= 1)
+	{
+		pos = fada_getposition(m);
+		fada_runanalyzejob(&job);
+		fada_setposition(m, pos);
+
+		return FADA_ERROR_SUCCESS;
+	}
+
+	// Worker threads and their buffers can't be created without allocating.
+	if (m->realtime)
+		return FADA_ERROR_WOULD_ALLOCATE;
+
+	jobs = (fada_AnalyzeJob*)fada_memalloc(threads * sizeof(fada_AnalyzeJob));
+	workers = (fada_AnalyzeWorker*)fada_memalloc(threads * sizeof(fada_AnalyzeWorker));
+	handles = (fada_Thread**)fada_memalloc(threads * sizeof(fada_Thread*));
+
+	if (!jobs || !workers || !handles)
+	{
+		err = FADA_ERROR_NOT_ENOUGH_MEMORY;
+		created = 0;
+		goto cleanup;
+	}
+
+	// Split the windows into contiguous ranges. The calling thread takes the first range.
+	for (t = 0, first = 0; t < threads; ++t)
+	{
+		jobs[t] = job;
+		jobs[t].first = first;
+		jobs[t].count = job.count / threads + (t < job.count % threads ? 1 : 0);
+
+		first += jobs[t].count;
+	}
+
+	// Every range runs on a copy of the manager, so the manager's ring can keep syncing until the workers are done.
+	for (created = 0; created < threads; ++created)
+	{
+		err = fada_newworkermanager(&workers[created], m, features);
+		if (err != FADA_ERROR_SUCCESS)
+			goto cleanup;
+
+		jobs[created].m = &workers[created].m;
+	}
+
+	for (t = 1; t < threads; ++t)
+		handles[t] = fada_newthread(fada_runanalyzejob, &jobs[t]);
+
+	fada_runanalyzejob(&jobs[0]);
+
+	for (t = 1; t < threads; ++t)
+	{
+		// Do the work here if the thread couldn't be started.
+		if (handles[t])
+			fada_jointhread(handles[t]);
+		else
+			fada_runanalyzejob(&jobs[t]);
+	}
+
+cleanup:
+	for (t = 0; t < created; ++t)
+		fada_closeworkermanager(&workers[t]);
+
+	if (jobs)
+		fada_memfree(jobs);
+	if (workers)
+		fada_memfree(workers);
+	if (handles)
+		fada_memfree(handles);
+
+	return err;
 }
\ No newline at end of file
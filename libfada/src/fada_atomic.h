@@ -0,0 +1,44 @@
+/***********************************************************************************
+ * libfada - Free Audio Detection and Analyzation Library                          *
+ *                                                                                 *
+ * The zlib/libpng License                                                         *
+ * Copyright (c) 2013 Nathan Cousins                                               *
+ *                                                                                 *
+ * This software is provided 'as-is', without any express or implied warranty.     *
+ * In no event will the authors be held liable for any damages arising from the    *
+ * use of this software.                                                           *
+ *                                                                                 *
+ * Permission is granted to anyone to use this software for any purpose,           *
+ * including commercial applications, and to alter it and redistribute it freely,  *
+ * subject to the following restrictions:                                          *
+ *                                                                                 *
+ * 1. The origin of this software must not be misrepresented; you must not claim   *
+ *    that you wrote the original software. If you use this software in a product, *
+ *    an acknowledgment in the product documentation would be appreciated but is   *
+ *    not required.                                                                *
+ *                                                                                 *
+ * 2. Altered source versions must be plainly marked as such, and must not be      *
+ *    misrepresented as being the original software.                               *
+ *                                                                                 *
+ * 3. This notice may not be removed or altered from any source distribution.      *
+ ***********************************************************************************/
+
+#ifndef _FADA_ATOMIC_H
+#define _FADA_ATOMIC_H
+
+#include <fada/fada_def.h>
+
+// Position shared between a producer and a consumer thread.
+typedef volatile fada_Pos fada_AtomicPos;
+
+// fada_atomicload has acquire semantics, fada_atomicstore has release semantics.
+#if defined(_MSC_VER)
+	#include <intrin.h>
+	#define fada_atomicload(p)    ((fada_Pos)_InterlockedOr64((volatile __int64*)(p), 0))
+	#define fada_atomicstore(p,v) ((void)_InterlockedExchange64((volatile __int64*)(p), (__int64)(v)))
+#else
+	#define fada_atomicload(p)    ((fada_Pos)__atomic_load_n((p), __ATOMIC_ACQUIRE))
+	#define fada_atomicstore(p,v) __atomic_store_n((p), (fada_Pos)(v), __ATOMIC_RELEASE)
+#endif
+
+#endif
\ No newline at end of file
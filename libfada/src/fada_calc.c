@@ -27,1546 +27,370 @@
 #include "fada_calc.h"
 #include "fada_manager.h"
 #include "fada_fftbuffer.h"
+#include "fada_fftplan.h"
 #include "fada_mem.h"
 
+#include <limits.h>
 #include <math.h>
 #include <stdio.h>
 
 #define _FADA_FFT_SWAP(a,b) tempr=(a);(a)=(b);(b)=tempr
 #define _FADA_MIN(a,b) ((a)>(b)?(b):(a))
-#define _FADA_PI 3.1415926535897932384626433832795028842
 
+// Number of window slides after which the running beat and bass sums are recomputed from scratch.
+#define _FADA_SUMS_REFRESH 64
 
-//////////////////////////////////////////////////
-void fada_fillwindowbuffer_i8(fada_Manager* m)
-{
-	char* buf = (char*)m->window.buffer;
-	fada_Chunk* chunk = m->current_chunk;
-	unsigned int i, o, n;
-
-	if (m->window.filled)
-		return;
-
-	o = m->current_sample;
-
-	for (i = 0; i < m->window.size; i += n)
-	{
-		if (chunk)
-		{
-			n = _FADA_MIN(chunk->sample_count - o, m->window.size - i);
-			fada_memcopy(&buf[i], &((char*)chunk->samples)[o], n);
-			
-			chunk = chunk->next;
-			o = 0;
-		}
-		else
-		{
-			fada_memzero(&buf[i], (m->window.size - i));
-			break;
-		}
-	}
-	
-	m->window.filled = FADA_TRUE;
-}
-
-
-//////////////////////////////////////////////////
-void fada_fillwindowbuffer_i16(fada_Manager* m)
-{
-	short* buf = (short*)m->window.buffer;
-	fada_Chunk* chunk = m->current_chunk;
-	unsigned int i, o, n;
-
-	if (m->window.filled)
-		return;
-
-	o = m->current_sample;
-
-	for (i = 0; i < m->window.size; i += n)
-	{
-		if (chunk)
-		{
-			n = _FADA_MIN(chunk->sample_count - o, m->window.size - i);
-			fada_memcopy(&buf[i], &((short*)chunk->samples)[o], n * sizeof(short));
-			
-			chunk = chunk->next;
-			o = 0;
-		}
-		else
-		{
-			fada_memzero(&buf[i], (m->window.size - i) * sizeof(short));
-			break;
-		}
-	}
-	
-	m->window.filled = FADA_TRUE;
-}
-
-
-//////////////////////////////////////////////////
-void fada_fillwindowbuffer_i32(fada_Manager* m)
-{
-	int* buf = (int*)m->window.buffer;
-	fada_Chunk* chunk = m->current_chunk;
-	unsigned int i, o, n;
-
-	if (m->window.filled)
-		return;
-
-	o = m->current_sample;
-
-	for (i = 0; i < m->window.size; i += n)
-	{
-		if (chunk)
-		{
-			n = _FADA_MIN(chunk->sample_count - o, m->window.size - i);
-			fada_memcopy(&buf[i], &((int*)chunk->samples)[o], n * sizeof(int));
-			
-			chunk = chunk->next;
-			o = 0;
-		}
-		else
-		{
-			fada_memzero(&buf[i], (m->window.size - i) * sizeof(int));
-			break;
-		}
-	}
-	
-	m->window.filled = FADA_TRUE;
-}
-
-
-//////////////////////////////////////////////////
-void fada_fillwindowbuffer_i64(fada_Manager* m)
-{
-	long long* buf = (long long*)m->window.buffer;
-	fada_Chunk* chunk = m->current_chunk;
-	unsigned int i, o, n;
-
-	if (m->window.filled)
-		return;
-
-	o = m->current_sample;
-
-	for (i = 0; i < m->window.size; i += n)
-	{
-		if (chunk)
-		{
-			n = _FADA_MIN(chunk->sample_count - o, m->window.size - i);
-			fada_memcopy(&buf[i], &((long long*)chunk->samples)[o], n * sizeof(long long));
-			
-			chunk = chunk->next;
-			o = 0;
-		}
-		else
-		{
-			fada_memzero(&buf[i], (m->window.size - i) * sizeof(long long));
-			break;
-		}
-	}
-	
-	m->window.filled = FADA_TRUE;
-}
-
-
-//////////////////////////////////////////////////
-void fada_fillwindowbuffer_f32(fada_Manager* m)
-{
-	float* buf = (float*)m->window.buffer;
-	fada_Chunk* chunk = m->current_chunk;
-	unsigned int i, o, n;
-
-	if (m->window.filled)
-		return;
-
-	o = m->current_sample;
-
-	for (i = 0; i < m->window.size; i += n)
-	{
-		if (chunk)
-		{
-			n = _FADA_MIN(chunk->sample_count - o, m->window.size - i);
-			fada_memcopy(&buf[i], &((float*)chunk->samples)[o], n * sizeof(float));
-			
-			chunk = chunk->next;
-			o = 0;
-		}
-		else
-		{
-			fada_memzero(&buf[i], (m->window.size - i) * sizeof(float));
-			break;
-		}
-	}
-	
-	m->window.filled = FADA_TRUE;
-}
-
-
-//////////////////////////////////////////////////
-void fada_fillwindowbuffer_f64(fada_Manager* m)
-{
-	double* buf = (double*)m->window.buffer;
-	fada_Chunk* chunk = m->current_chunk;
-	unsigned int i, o, n;
-
-	if (m->window.filled)
-		return;
-
-	o = m->current_sample;
-
-	for (i = 0; i < m->window.size; i += n)
-	{
-		if (chunk)
-		{
-			n = _FADA_MIN(chunk->sample_count - o, m->window.size - i);
-			fada_memcopy(&buf[i], &((double*)chunk->samples)[o], n * sizeof(double));
-			
-			chunk = chunk->next;
-			o = 0;
-		}
-		else
-		{
-			fada_memzero(&buf[i], (m->window.size - i) * sizeof(double));
-			break;
-		}
-	}
-	
-	m->window.filled = FADA_TRUE;
-}
-
-
-//////////////////////////////////////////////////
-fada_Res fada_getsample_i8(fada_Manager* m, fada_Pos pos)
-{
-	const char* buf = (char*)m->window.buffer;
-	fada_fillwindowbuffer_i8(m);
-
-	return (fada_Res)buf[pos];
-}
-
-
-//////////////////////////////////////////////////
-fada_Res fada_getsample_i16(fada_Manager* m, fada_Pos pos)
-{
-	const short* buf = (short*)m->window.buffer;
-	fada_fillwindowbuffer_i16(m);
-
-	return (fada_Res)buf[pos];
-}
-
-
-//////////////////////////////////////////////////
-fada_Res fada_getsample_i32(fada_Manager* m, fada_Pos pos)
-{
-	const int* buf = (int*)m->window.buffer;
-	fada_fillwindowbuffer_i32(m);
-
-	return (fada_Res)buf[pos];
-}
-
-
-//////////////////////////////////////////////////
-fada_Res fada_getsample_i64(fada_Manager* m, fada_Pos pos)
-{
-	const long long* buf = (long long*)m->window.buffer;
-	fada_fillwindowbuffer_i64(m);
-
-	return (fada_Res)buf[pos];
-}
-
-
-//////////////////////////////////////////////////
-fada_Res fada_getsample_f32(fada_Manager* m, fada_Pos pos)
-{
-	const float* buf = (float*)m->window.buffer;
-	fada_fillwindowbuffer_f32(m);
-
-	return (fada_Res)buf[pos];
-}
-
-
-//////////////////////////////////////////////////
-fada_Res fada_getsample_f64(fada_Manager* m, fada_Pos pos)
-{
-	const double* buf = (double*)m->window.buffer;
-	fada_fillwindowbuffer_f64(m);
-
-	return (fada_Res)buf[pos];
-}
-
-
-//////////////////////////////////////////////////
-void fada_getsamples_i8(fada_Manager* m, unsigned int channel, fada_Res* out_results)
-{
-	unsigned int i, sz;
-	const char* buf = (char*)m->window.buffer;
-	fada_fillwindowbuffer_i8(m);
-
-	for (i = 0, sz = m->window.size / m->channels; i < sz; ++i)
-	{
-		out_results[i] = (fada_Res)buf[i * m->channels + channel];
-	}
-}
-
-
-//////////////////////////////////////////////////
-void fada_getsamples_i16(fada_Manager* m, unsigned int channel, fada_Res* out_results)
-{
-	unsigned int i, sz;
-	const short* buf = (short*)m->window.buffer;
-	fada_fillwindowbuffer_i16(m);
-
-	for (i = 0, sz = m->window.size / m->channels; i < sz; ++i)
-	{
-		out_results[i] = (fada_Res)buf[i * m->channels + channel];
-	}
-}
-
-
-//////////////////////////////////////////////////
-void fada_getsamples_i32(fada_Manager* m, unsigned int channel, fada_Res* out_results)
-{
-	unsigned int i, sz;
-	const int* buf = (int*)m->window.buffer;
-	fada_fillwindowbuffer_i32(m);
-
-	for (i = 0, sz = m->window.size / m->channels; i < sz; ++i)
-	{
-		out_results[i] = (fada_Res)buf[i * m->channels + channel];
-	}
-}
-
-
-//////////////////////////////////////////////////
-void fada_getsamples_i64(fada_Manager* m, unsigned int channel, fada_Res* out_results)
-{
-	unsigned int i, sz;
-	const long long* buf = (long long*)m->window.buffer;
-	fada_fillwindowbuffer_i64(m);
-
-	for (i = 0, sz = m->window.size / m->channels; i < sz; ++i)
-	{
-		out_results[i] = (fada_Res)buf[i * m->channels + channel];
-	}
-}
-
-
-//////////////////////////////////////////////////
-void fada_getsamples_f32(fada_Manager* m, unsigned int channel, fada_Res* out_results)
-{
-	unsigned int i, sz;
-	const float* buf = (float*)m->window.buffer;
-	fada_fillwindowbuffer_f32(m);
-
-	for (i = 0, sz = m->window.size / m->channels; i < sz; ++i)
-	{
-		out_results[i] = (fada_Res)buf[i * m->channels + channel];
-	}
-}
-
-
-//////////////////////////////////////////////////
-void fada_getsamples_f64(fada_Manager* m, unsigned int channel, fada_Res* out_results)
-{
-	unsigned int i, sz;
-	const double* buf = (double*)m->window.buffer;
-	fada_fillwindowbuffer_f64(m);
-
-	for (i = 0, sz = m->window.size / m->channels; i < sz; ++i)
-	{
-		out_results[i] = (fada_Res)buf[i * m->channels + channel];
-	}
-}
-
-
-//////////////////////////////////////////////////
-fada_Res fada_getframe_i8(fada_Manager* m, fada_Pos pos)
-{
-	unsigned int i;
-	fada_Res res = 0.;
-
-	const char* buf = (char*)m->window.buffer;
-	fada_fillwindowbuffer_i8(m);
-
-	for (i = 0; i < m->channels; ++i)
-		res += (fada_Res)buf[pos + i];
-
-	return res / m->channels;
-}
-
-
-//////////////////////////////////////////////////
-fada_Res fada_getframe_i16(fada_Manager* m, fada_Pos pos)
-{
-	unsigned int i;
-	fada_Res res = 0.;
-
-	const short* buf = (short*)m->window.buffer;
-	fada_fillwindowbuffer_i16(m);
-
-	for (i = 0; i < m->channels; ++i)
-		res += (fada_Res)buf[pos + i];
-
-	return res / m->channels;
-}
-
-
-//////////////////////////////////////////////////
-fada_Res fada_getframe_i32(fada_Manager* m, fada_Pos pos)
-{
-	unsigned int i;
-	fada_Res res = 0.;
-
-	const int* buf = (int*)m->window.buffer;
-	fada_fillwindowbuffer_i32(m);
-
-	for (i = 0; i < m->channels; ++i)
-		res += (fada_Res)buf[pos + i];
-
-	return res / m->channels;
-}
-
-
-//////////////////////////////////////////////////
-fada_Res fada_getframe_i64(fada_Manager* m, fada_Pos pos)
-{
-	unsigned int i;
-	fada_Res res = 0.;
-
-	const long long* buf = (long long*)m->window.buffer;
-	fada_fillwindowbuffer_i64(m);
-
-	for (i = 0; i < m->channels; ++i)
-		res += (fada_Res)buf[pos + i];
-
-	return res / m->channels;
-}
-
-
-//////////////////////////////////////////////////
-fada_Res fada_getframe_f32(fada_Manager* m, fada_Pos pos)
-{
-	unsigned int i;
-	fada_Res res = 0.;
-
-	const float* buf = (float*)m->window.buffer;
-	fada_fillwindowbuffer_f32(m);
-
-	for (i = 0; i < m->channels; ++i)
-		res += (fada_Res)buf[pos + i];
-
-	return res / m->channels;
-}
-
-
-//////////////////////////////////////////////////
-fada_Res fada_getframe_f64(fada_Manager* m, fada_Pos pos)
-{
-	unsigned int i;
-	fada_Res res = 0.;
-
-	const double* buf = (double*)m->window.buffer;
-	fada_fillwindowbuffer_f64(m);
-
-	for (i = 0; i < m->channels; ++i)
-		res += (fada_Res)buf[pos + i];
-
-	return res / m->channels;
-}
-
-
-//////////////////////////////////////////////////
-void fada_getframes_i8(fada_Manager* m, fada_Res* out_results)
-{
-	unsigned int i, j, sz;
-	const char* buf = (char*)m->window.buffer;
-	fada_fillwindowbuffer_i8(m);
-
-	for (i = 0, sz = m->window.size / m->channels; i < sz; ++i)
-	{
-		for (j = 0; j < m->channels; ++j)
-			out_results[i] = (fada_Res)buf[i * m->channels + j];
-
-		out_results[i] /= m->channels;
-	}
-}
-
-
-//////////////////////////////////////////////////
-void fada_getframes_i16(fada_Manager* m, fada_Res* out_results)
-{
-	unsigned int i, j, sz;
-	const short* buf = (short*)m->window.buffer;
-	fada_fillwindowbuffer_i16(m);
-
-	for (i = 0, sz = m->window.size / m->channels; i < sz; ++i)
-	{
-		for (j = 0; j < m->channels; ++j)
-			out_results[i] = (fada_Res)buf[i * m->channels + j];
-
-		out_results[i] /= m->channels;
-	}
-}
-
-
-//////////////////////////////////////////////////
-void fada_getframes_i32(fada_Manager* m, fada_Res* out_results)
-{
-	unsigned int i, j, sz;
-	const int* buf = (int*)m->window.buffer;
-	fada_fillwindowbuffer_i32(m);
-
-	for (i = 0, sz = m->window.size / m->channels; i < sz; ++i)
-	{
-		for (j = 0; j < m->channels; ++j)
-			out_results[i] = (fada_Res)buf[i * m->channels + j];
-
-		out_results[i] /= m->channels;
-	}
-}
-
-
-//////////////////////////////////////////////////
-void fada_getframes_i64(fada_Manager* m, fada_Res* out_results)
-{
-	unsigned int i, j, sz;
-	const long long* buf = (long long*)m->window.buffer;
-	fada_fillwindowbuffer_i64(m);
-
-	for (i = 0, sz = m->window.size / m->channels; i < sz; ++i)
-	{
-		for (j = 0; j < m->channels; ++j)
-			out_results[i] = (fada_Res)buf[i * m->channels + j];
-
-		out_results[i] /= m->channels;
-	}
-}
-
-
-//////////////////////////////////////////////////
-void fada_getframes_f32(fada_Manager* m, fada_Res* out_results)
-{
-	unsigned int i, j, sz;
-	const float* buf = (float*)m->window.buffer;
-	fada_fillwindowbuffer_f32(m);
-
-	for (i = 0, sz = m->window.size / m->channels; i < sz; ++i)
-	{
-		for (j = 0; j < m->channels; ++j)
-			out_results[i] = (fada_Res)buf[i * m->channels + j];
-
-		out_results[i] /= m->channels;
-	}
-}
-
-
-//////////////////////////////////////////////////
-void fada_getframes_f64(fada_Manager* m, fada_Res* out_results)
-{
-	unsigned int i, j, sz;
-	const double* buf = (double*)m->window.buffer;
-	fada_fillwindowbuffer_f64(m);
-
-	for (i = 0, sz = m->window.size / m->channels; i < sz; ++i)
-	{
-		for (j = 0; j < m->channels; ++j)
-			out_results[i] = (fada_Res)buf[i * m->channels + j];
-
-		out_results[i] /= m->channels;
-	}
-}
-
-
-//////////////////////////////////////////////////
-fada_Res fada_calcbeat_i8(fada_Manager* m)
-{
-	unsigned int i, chan;
-	fada_Res beat, avg;
-	
-	const char* samples = (char*)m->window.buffer;
-	fada_fillwindowbuffer_i8(m);
-
-	beat = 0.;
-	for (i = 0; i < m->window.size; i += m->channels)
-	{
-		avg = 0.;
-
-		for (chan = 0; chan < m->channels; ++chan)
-			avg += abs(samples[i + chan] - samples[i + chan + m->channels]);
-
-		beat += avg / m->channels;
-	}
-
-	return beat / (m->window.size / m->channels);
-}
-
-
-//////////////////////////////////////////////////
-fada_Res fada_calcbeat_i16(fada_Manager* m)
-{
-	unsigned int i, chan;
-	fada_Res beat, avg;
-	
-	const short* samples = (short*)m->window.buffer;
-	fada_fillwindowbuffer_i16(m);
-
-	beat = 0.;
-	for (i = 0; i < m->window.size; i += m->channels)
-	{
-		avg = 0.;
 
-		for (chan = 0; chan < m->channels; ++chan)
-			avg += abs(samples[i + chan] - samples[i + chan + m->channels]);
+// Instantiate the kernels in fada_kernel.h for every sample type, once for any channel count and once each for mono and stereo.
+// The normalizers must match fada_getnormalizer.
+#define _FADA_KERNEL_T char
+#define _FADA_KERNEL_ABS abs
+#define _FADA_KERNEL_NORMAL ((fada_Res)UCHAR_MAX / 2.)
 
-		beat += avg / m->channels;
-	}
-
-	return beat / (m->window.size / m->channels);
-}
-
-
-//////////////////////////////////////////////////
-fada_Res fada_calcbeat_i32(fada_Manager* m)
-{
-	unsigned int i, chan;
-	fada_Res beat, avg;
-	
-	const int* samples = (int*)m->window.buffer;
-	fada_fillwindowbuffer_i8(m);
-
-	beat = 0.;
-	for (i = 0; i < m->window.size; i += m->channels)
-	{
-		avg = 0.;
-
-		for (chan = 0; chan < m->channels; ++chan)
-			avg += abs(samples[i + chan] - samples[i + chan + m->channels]);
-
-		beat += avg / m->channels;
-	}
-
-	return beat / (m->window.size / m->channels);
-}
-
-
-//////////////////////////////////////////////////
-fada_Res fada_calcbeat_i64(fada_Manager* m)
-{
-	unsigned int i, chan;
-	fada_Res beat, avg;
-	
-	const long long* samples = (long long*)m->window.buffer;
-	fada_fillwindowbuffer_i64(m);
-
-	beat = 0.;
-	for (i = 0; i < m->window.size; i += m->channels)
-	{
-		avg = 0.;
-
-		for (chan = 0; chan < m->channels; ++chan)
-			avg += llabs(samples[i + chan] - samples[i + chan + m->channels]);
-
-		beat += avg / m->channels;
-	}
-
-	return beat / (m->window.size / m->channels);
-}
-
-
-//////////////////////////////////////////////////
-fada_Res fada_calcbeat_f32(fada_Manager* m)
-{
-	unsigned int i, chan;
-	fada_Res beat, avg;
-	
-	const float* samples = (float*)m->window.buffer;
-	fada_fillwindowbuffer_f32(m);
-
-	beat = 0.;
-	for (i = 0; i < m->window.size; i += m->channels)
-	{
-		avg = 0.;
-
-		for (chan = 0; chan < m->channels; ++chan)
-			avg += fabs(samples[i + chan] - samples[i + chan + m->channels]);
-
-		beat += avg / m->channels;
-	}
-
-	return beat / (m->window.size / m->channels);
-}
-
-
-//////////////////////////////////////////////////
-fada_Res fada_calcbeat_f64(fada_Manager* m)
-{
-	unsigned int i, chan;
-	fada_Res beat, avg;
-	
-	const double* samples = (double*)m->window.buffer;
-	fada_fillwindowbuffer_f64(m);
-
-	beat = 0.;
-	for (i = 0; i < m->window.size; i += m->channels)
-	{
-		avg = 0.;
-
-		for (chan = 0; chan < m->channels; ++chan)
-			avg += fabs(samples[i + chan] - samples[i + chan + m->channels]);
-
-		beat += avg / m->channels;
-	}
-
-	return beat / (m->window.size / m->channels);
-}
-
-
-//////////////////////////////////////////////////
-fada_Res fada_calcbeat_channel_i8(fada_Manager* m, unsigned int chan)
-{
-	unsigned int i;
-	fada_Res beat;
-	
-	const char* samples = (char*)m->window.buffer;
-	fada_fillwindowbuffer_i8(m);
-
-	beat = 0.;
-	for (i = 0; i < m->window.size; i += m->channels)
-	{
-		beat += abs(samples[i + chan] - samples[i + chan + m->channels]);
-	}
-
-	return beat / (m->window.size / m->channels);
-}
-
-
-//////////////////////////////////////////////////
-fada_Res fada_calcbeat_channel_i16(fada_Manager* m, unsigned int chan)
-{
-	unsigned int i;
-	fada_Res beat;
-	
-	const short* samples = (short*)m->window.buffer;
-	fada_fillwindowbuffer_i16(m);
-
-	beat = 0.;
-	for (i = 0; i < m->window.size; i += m->channels)
-	{
-		beat += abs(samples[i + chan] - samples[i + chan + m->channels]);
-	}
-
-	return beat / (m->window.size / m->channels);
-}
-
-
-//////////////////////////////////////////////////
-fada_Res fada_calcbeat_channel_i32(fada_Manager* m, unsigned int chan)
-{
-	unsigned int i;
-	fada_Res beat;
-	
-	const int* samples = (int*)m->window.buffer;
-	fada_fillwindowbuffer_i32(m);
-
-	beat = 0.;
-	for (i = 0; i < m->window.size; i += m->channels)
-	{
-		beat += abs(samples[i + chan] - samples[i + chan + m->channels]);
-	}
-
-	return beat / (m->window.size / m->channels);
-}
-
-
-//////////////////////////////////////////////////
-fada_Res fada_calcbeat_channel_i64(fada_Manager* m, unsigned int chan)
-{
-	unsigned int i;
-	fada_Res beat;
-	
-	const long long* samples = (long long*)m->window.buffer;
-	fada_fillwindowbuffer_i64(m);
-
-	beat = 0.;
-	for (i = 0; i < m->window.size; i += m->channels)
-	{
-		beat += llabs(samples[i + chan] - samples[i + chan + m->channels]);
-	}
-
-	return beat / (m->window.size / m->channels);
-}
-
-
-//////////////////////////////////////////////////
-fada_Res fada_calcbeat_channel_f32(fada_Manager* m, unsigned int chan)
-{
-	unsigned int i;
-	fada_Res beat;
-	
-	const float* samples = (float*)m->window.buffer;
-	fada_fillwindowbuffer_f32(m);
-
-	beat = 0.;
-	for (i = 0; i < m->window.size; i += m->channels)
-	{
-		beat += fabs(samples[i + chan] - samples[i + chan + m->channels]);
-	}
-
-	return beat / (m->window.size / m->channels);
-}
-
-
-//////////////////////////////////////////////////
-fada_Res fada_calcbeat_channel_f64(fada_Manager* m, unsigned int chan)
-{
-	unsigned int i;
-	fada_Res beat;
-	
-	const double* samples = (double*)m->window.buffer;
-	fada_fillwindowbuffer_f64(m);
-
-	beat = 0.;
-	for (i = 0; i < m->window.size; i += m->channels)
-	{
-		beat += fabs(samples[i + chan] - samples[i + chan + m->channels]);
-	}
-
-	return beat / (m->window.size / m->channels);
-}
-
-
-//////////////////////////////////////////////////
-fada_Res fada_calcbass_i8(fada_Manager* m)
-{
-	unsigned int i, chan, subi;
-	fada_Res bass, chan_avg, sub_avg;
-	const unsigned int SUB_PERIOD = 32*m->channels;
-	
-	const char* samples = (char*)m->window.buffer;
-	fada_fillwindowbuffer_i8(m);
-
-	bass = 0.;
-	for (i = 0; i < m->window.size; i += SUB_PERIOD)
-	{
-		sub_avg = 0.;
-		for (subi = i; subi < i+SUB_PERIOD && subi < m->window.size; subi += m->channels)
-		{
-			chan_avg = 0.;
+#define _FADA_KERNEL_ID i8
+#define _FADA_KERNEL_CHANNELS 0
+#include "fada_kernel.h"
 
-			for (chan = 0; chan < m->channels; ++chan)
-				chan_avg += samples[subi + chan];
+#define _FADA_KERNEL_ID i8_mono
+#define _FADA_KERNEL_CHANNELS 1
+#include "fada_kernel.h"
 
-			sub_avg += chan_avg / m->channels;
-		}
-		bass += fabs(sub_avg / (SUB_PERIOD / m->channels));
-	}
-
-	return bass / ((m->window.size / m->channels) / SUB_PERIOD);
-}
-
-
-//////////////////////////////////////////////////
-/*
-fada_Res fada_calcbass_i16(fada_Manager* m)
-{
-	unsigned int i, chan;
-	fada_Res bass, chan_avg;
-	
-	const short* samples = &((short*)m->samples)[m->current_sample];
-	fada_Pos last_sample = (m->current_sample < m->samples_size) ? m->samples_size - m->current_sample : 0;
-
-	bass = 0.;
-	for (i = 0; i < m->window_size && i < last_sample; i += m->channels)
-	{
-		chan_avg = 0.;
-		for (chan = 0; chan < m->channels; ++chan)
-		{
-			chan_avg += abs(samples[i + chan]);
-		}
-		chan_avg /= m->channels;
-		bass += chan_avg;
-	}
-
-	return bass / (m->window_size / m->channels);
-}
-*/
-fada_Res fada_calcbass_i16(fada_Manager* m)
-{
-	unsigned int i, chan, subi;
-	fada_Res bass, chan_avg, sub_avg;
-	const unsigned int SUB_PERIOD = 32*m->channels;
-	
-	const short* samples = (short*)m->window.buffer;
-	fada_fillwindowbuffer_i16(m);
-
-	bass = 0.;
-	for (i = 0; i < m->window.size; i += SUB_PERIOD)
-	{
-		sub_avg = 0.;
-		for (subi = i; subi < i+SUB_PERIOD && subi < m->window.size; subi += m->channels)
-		{
-			chan_avg = 0.;
-
-			for (chan = 0; chan < m->channels; ++chan)
-				chan_avg += samples[subi + chan];
-
-			sub_avg += chan_avg / m->channels;
-		}
-		bass += fabs(sub_avg / (SUB_PERIOD / m->channels));
-	}
+#define _FADA_KERNEL_ID i8_stereo
+#define _FADA_KERNEL_CHANNELS 2
+#include "fada_kernel.h"
 
-	return bass / ((m->window.size / m->channels) / SUB_PERIOD);
-}
-
-
-
-//////////////////////////////////////////////////
-fada_Res fada_calcbass_i32(fada_Manager* m)
-{
-	unsigned int i, chan, subi;
-	fada_Res bass, chan_avg, sub_avg;
-	const unsigned int SUB_PERIOD = 32*m->channels;
-	
-	const int* samples = (int*)m->window.buffer;
-	fada_fillwindowbuffer_i32(m);
-
-	bass = 0.;
-	for (i = 0; i < m->window.size; i += SUB_PERIOD)
-	{
-		sub_avg = 0.;
-		for (subi = i; subi < i+SUB_PERIOD && subi < m->window.size; subi += m->channels)
-		{
-			chan_avg = 0.;
-
-			for (chan = 0; chan < m->channels; ++chan)
-				chan_avg += samples[subi + chan];
+#undef _FADA_KERNEL_NORMAL
+#undef _FADA_KERNEL_ABS
+#undef _FADA_KERNEL_T
 
-			sub_avg += chan_avg / m->channels;
-		}
-		bass += fabs(sub_avg / (SUB_PERIOD / m->channels));
-	}
-
-	return bass / ((m->window.size / m->channels) / SUB_PERIOD);
-}
 
+#define _FADA_KERNEL_T unsigned char
+#define _FADA_KERNEL_ABS abs
+#define _FADA_KERNEL_NORMAL ((fada_Res)UCHAR_MAX / 2.)
+#define _FADA_KERNEL_VALUE fada_uint8value
+#define _FADA_KERNEL_SILENCE 0x80
 
-//////////////////////////////////////////////////
-fada_Res fada_calcbass_i64(fada_Manager* m)
-{
-	unsigned int i, chan, subi;
-	fada_Res bass, chan_avg, sub_avg;
-	const unsigned int SUB_PERIOD = 32*m->channels;
-	
-	const long long* samples = (long long*)m->window.buffer;
-	fada_fillwindowbuffer_i64(m);
-
-	bass = 0.;
-	for (i = 0; i < m->window.size; i += SUB_PERIOD)
-	{
-		sub_avg = 0.;
-		for (subi = i; subi < i+SUB_PERIOD && subi < m->window.size; subi += m->channels)
-		{
-			chan_avg = 0.;
+#define _FADA_KERNEL_ID u8
+#define _FADA_KERNEL_CHANNELS 0
+#include "fada_kernel.h"
 
-			for (chan = 0; chan < m->channels; ++chan)
-				chan_avg += samples[subi + chan];
+#define _FADA_KERNEL_ID u8_mono
+#define _FADA_KERNEL_CHANNELS 1
+#include "fada_kernel.h"
 
-			sub_avg += chan_avg / m->channels;
-		}
-		bass += fabs(sub_avg / (SUB_PERIOD / m->channels));
-	}
+#define _FADA_KERNEL_ID u8_stereo
+#define _FADA_KERNEL_CHANNELS 2
+#include "fada_kernel.h"
 
-	return bass / ((m->window.size / m->channels) / SUB_PERIOD);
-}
+#undef _FADA_KERNEL_SILENCE
+#undef _FADA_KERNEL_VALUE
+#undef _FADA_KERNEL_NORMAL
+#undef _FADA_KERNEL_ABS
+#undef _FADA_KERNEL_T
 
 
-//////////////////////////////////////////////////
-fada_Res fada_calcbass_f32(fada_Manager* m)
-{
-	unsigned int i, chan, subi;
-	fada_Res bass, chan_avg, sub_avg;
-	const unsigned int SUB_PERIOD = 32*m->channels;
-	
-	const float* samples = (float*)m->window.buffer;
-	fada_fillwindowbuffer_f32(m);
-
-	bass = 0.;
-	for (i = 0; i < m->window.size; i += SUB_PERIOD)
-	{
-		sub_avg = 0.;
-		for (subi = i; subi < i+SUB_PERIOD && subi < m->window.size; subi += m->channels)
-		{
-			chan_avg = 0.;
+#define _FADA_KERNEL_T short
+#define _FADA_KERNEL_ABS abs
+#define _FADA_KERNEL_NORMAL ((fada_Res)USHRT_MAX / 2.)
 
-			for (chan = 0; chan < m->channels; ++chan)
-				chan_avg += samples[subi + chan];
+#define _FADA_KERNEL_ID i16
+#define _FADA_KERNEL_CHANNELS 0
+#include "fada_kernel.h"
 
-			sub_avg += chan_avg / m->channels;
-		}
-		bass += fabs(sub_avg / (SUB_PERIOD / m->channels));
-	}
+#define _FADA_KERNEL_ID i16_mono
+#define _FADA_KERNEL_CHANNELS 1
+#include "fada_kernel.h"
 
-	return bass / ((m->window.size / m->channels) / SUB_PERIOD);
-}
+#define _FADA_KERNEL_ID i16_stereo
+#define _FADA_KERNEL_CHANNELS 2
+#include "fada_kernel.h"
 
+#undef _FADA_KERNEL_NORMAL
+#undef _FADA_KERNEL_ABS
+#undef _FADA_KERNEL_T
 
-//////////////////////////////////////////////////
-fada_Res fada_calcbass_f64(fada_Manager* m)
-{
-	unsigned int i, chan, subi;
-	fada_Res bass, chan_avg, sub_avg;
-	const unsigned int SUB_PERIOD = 32*m->channels;
-	
-	const double* samples = (double*)m->window.buffer;
-	fada_fillwindowbuffer_f64(m);
-
-	bass = 0.;
-	for (i = 0; i < m->window.size; i += SUB_PERIOD)
-	{
-		sub_avg = 0.;
-		for (subi = i; subi < i+SUB_PERIOD && subi < m->window.size; subi += m->channels)
-		{
-			chan_avg = 0.;
 
-			for (chan = 0; chan < m->channels; ++chan)
-				chan_avg += samples[subi + chan];
+#define _FADA_KERNEL_T fada_Int24
+#define _FADA_KERNEL_ABS abs
+#define _FADA_KERNEL_NORMAL ((fada_Res)0xFFFFFF / 2.)
+#define _FADA_KERNEL_VALUE fada_int24value
 
-			sub_avg += chan_avg / m->channels;
-		}
-		bass += fabs(sub_avg / (SUB_PERIOD / m->channels));
-	}
+#define _FADA_KERNEL_ID i24
+#define _FADA_KERNEL_CHANNELS 0
+#include "fada_kernel.h"
 
-	return bass / ((m->window.size / m->channels) / SUB_PERIOD);
-}
+#define _FADA_KERNEL_ID i24_mono
+#define _FADA_KERNEL_CHANNELS 1
+#include "fada_kernel.h"
 
+#define _FADA_KERNEL_ID i24_stereo
+#define _FADA_KERNEL_CHANNELS 2
+#include "fada_kernel.h"
 
-//////////////////////////////////////////////////
-fada_Res fada_calcbass_channel_i8(fada_Manager* m, unsigned int chan)
-{
-	unsigned int i, subi;
-	fada_Res bass, sub_avg;
-	const unsigned int SUB_PERIOD = 32*m->channels;
-	
-	const char* samples = (char*)m->window.buffer;
-	fada_fillwindowbuffer_i8(m);
-
-	bass = 0.;
-	for (i = 0; i < m->window.size; i += SUB_PERIOD)
-	{
-		sub_avg = 0.;
+#undef _FADA_KERNEL_VALUE
+#undef _FADA_KERNEL_NORMAL
+#undef _FADA_KERNEL_ABS
+#undef _FADA_KERNEL_T
 
-		for (subi = i; subi < i+SUB_PERIOD && subi < m->window.size; subi += m->channels)
-			sub_avg += samples[i + chan];
 
-		bass += fabs(sub_avg / (SUB_PERIOD / m->channels));
-	}
+#define _FADA_KERNEL_T int
+#define _FADA_KERNEL_ABS abs
+#define _FADA_KERNEL_NORMAL ((fada_Res)UINT_MAX / 2.)
 
-	return bass / ((m->window.size / m->channels) / SUB_PERIOD);
-}
+#define _FADA_KERNEL_ID i32
+#define _FADA_KERNEL_CHANNELS 0
+#include "fada_kernel.h"
 
+#define _FADA_KERNEL_ID i32_mono
+#define _FADA_KERNEL_CHANNELS 1
+#include "fada_kernel.h"
 
-//////////////////////////////////////////////////
-/*
-fada_Res fada_calcbass_channel_i16(fada_Manager* m, unsigned int chan)
-{
-	unsigned int i;
-	fada_Res bass;
-	
-	const short* samples = &((short*)m->samples)[m->current_sample];
-	fada_Pos last_sample = (m->current_sample < m->samples_size) ? m->samples_size - m->current_sample : 0;
-
-	bass = 0.;
-	for (i = 0; i < m->window_size && i < last_sample; i += m->channels)
-	{
-		bass += abs(samples[i + chan]);
-	}
+#define _FADA_KERNEL_ID i32_stereo
+#define _FADA_KERNEL_CHANNELS 2
+#include "fada_kernel.h"
 
-	return bass / (m->window_size / m->channels);
-}
-*/
-fada_Res fada_calcbass_channel_i16(fada_Manager* m, unsigned int chan)
-{
-	unsigned int i, subi;
-	fada_Res bass, sub_avg;
-	const unsigned int SUB_PERIOD = 32*m->channels;
-	
-	const short* samples = (short*)m->window.buffer;
-	fada_fillwindowbuffer_i16(m);
-
-	bass = 0.;
-	for (i = 0; i < m->window.size; i += SUB_PERIOD)
-	{
-		sub_avg = 0.;
+#undef _FADA_KERNEL_NORMAL
+#undef _FADA_KERNEL_ABS
+#undef _FADA_KERNEL_T
 
-		for (subi = i; subi < i+SUB_PERIOD && subi < m->window.size; subi += m->channels)
-			sub_avg += samples[i + chan];
 
-		bass += fabs(sub_avg / (SUB_PERIOD / m->channels));
-	}
+#define _FADA_KERNEL_T long long
+#define _FADA_KERNEL_ABS llabs
+#define _FADA_KERNEL_NORMAL ((fada_Res)ULLONG_MAX / 2.)
 
-	return bass / ((m->window.size / m->channels) / SUB_PERIOD);
-}
+#define _FADA_KERNEL_ID i64
+#define _FADA_KERNEL_CHANNELS 0
+#include "fada_kernel.h"
 
+#define _FADA_KERNEL_ID i64_mono
+#define _FADA_KERNEL_CHANNELS 1
+#include "fada_kernel.h"
 
-//////////////////////////////////////////////////
-fada_Res fada_calcbass_channel_i32(fada_Manager* m, unsigned int chan)
-{
-	unsigned int i, subi;
-	fada_Res bass, sub_avg;
-	const unsigned int SUB_PERIOD = 32*m->channels;
-	
-	const int* samples = (int*)m->window.buffer;
-	fada_fillwindowbuffer_i32(m);
-
-	bass = 0.;
-	for (i = 0; i < m->window.size; i += SUB_PERIOD)
-	{
-		sub_avg = 0.;
+#define _FADA_KERNEL_ID i64_stereo
+#define _FADA_KERNEL_CHANNELS 2
+#include "fada_kernel.h"
 
-		for (subi = i; subi < i+SUB_PERIOD && subi < m->window.size; subi += m->channels)
-			sub_avg += samples[i + chan];
+#undef _FADA_KERNEL_NORMAL
+#undef _FADA_KERNEL_ABS
+#undef _FADA_KERNEL_T
 
-		bass += fabs(sub_avg / (SUB_PERIOD / m->channels));
-	}
 
-	return bass / ((m->window.size / m->channels) / SUB_PERIOD);
-}
+#define _FADA_KERNEL_T float
+#define _FADA_KERNEL_ABS fabs
 
+#define _FADA_KERNEL_ID f32
+#define _FADA_KERNEL_CHANNELS 0
+#include "fada_kernel.h"
 
-//////////////////////////////////////////////////
-fada_Res fada_calcbass_channel_i64(fada_Manager* m, unsigned int chan)
-{
-	unsigned int i, subi;
-	fada_Res bass, sub_avg;
-	const unsigned int SUB_PERIOD = 32*m->channels;
-	
-	const long long* samples = (long long*)m->window.buffer;
-	fada_fillwindowbuffer_i64(m);
-
-	bass = 0.;
-	for (i = 0; i < m->window.size; i += SUB_PERIOD)
-	{
-		sub_avg = 0.;
+#define _FADA_KERNEL_ID f32_mono
+#define _FADA_KERNEL_CHANNELS 1
+#include "fada_kernel.h"
 
-		for (subi = i; subi < i+SUB_PERIOD && subi < m->window.size; subi += m->channels)
-			sub_avg += samples[i + chan];
+#define _FADA_KERNEL_ID f32_stereo
+#define _FADA_KERNEL_CHANNELS 2
+#include "fada_kernel.h"
 
-		bass += fabs(sub_avg / (SUB_PERIOD / m->channels));
-	}
+#undef _FADA_KERNEL_ABS
+#undef _FADA_KERNEL_T
 
-	return bass / ((m->window.size / m->channels) / SUB_PERIOD);
-}
 
+#define _FADA_KERNEL_T double
+#define _FADA_KERNEL_ABS fabs
 
-//////////////////////////////////////////////////
-fada_Res fada_calcbass_channel_f32(fada_Manager* m, unsigned int chan)
-{
-	unsigned int i, subi;
-	fada_Res bass, sub_avg;
-	const unsigned int SUB_PERIOD = 32*m->channels;
-	
-	const float* samples = (float*)m->window.buffer;
-	fada_fillwindowbuffer_f32(m);
-
-	bass = 0.;
-	for (i = 0; i < m->window.size; i += SUB_PERIOD)
-	{
-		sub_avg = 0.;
+#define _FADA_KERNEL_ID f64
+#define _FADA_KERNEL_CHANNELS 0
+#include "fada_kernel.h"
 
-		for (subi = i; subi < i+SUB_PERIOD && subi < m->window.size; subi += m->channels)
-			sub_avg += samples[i + chan];
+#define _FADA_KERNEL_ID f64_mono
+#define _FADA_KERNEL_CHANNELS 1
+#include "fada_kernel.h"
 
-		bass += fabs(sub_avg / (SUB_PERIOD / m->channels));
-	}
+#define _FADA_KERNEL_ID f64_stereo
+#define _FADA_KERNEL_CHANNELS 2
+#include "fada_kernel.h"
 
-	return bass / ((m->window.size / m->channels) / SUB_PERIOD);
-}
+#undef _FADA_KERNEL_ABS
+#undef _FADA_KERNEL_T
 
 
 //////////////////////////////////////////////////
-fada_Res fada_calcbass_channel_f64(fada_Manager* m, unsigned int chan)
+const fada_Kernels* fada_getkernels(fada_TSample type, unsigned int channels)
 {
-	unsigned int i, subi;
-	fada_Res bass, sub_avg;
-	const unsigned int SUB_PERIOD = 32*m->channels;
-	
-	const double* samples = (double*)m->window.buffer;
-	fada_fillwindowbuffer_f64(m);
-
-	bass = 0.;
-	for (i = 0; i < m->window.size; i += SUB_PERIOD)
+	switch (type)
 	{
-		sub_avg = 0.;
-
-		for (subi = i; subi < i+SUB_PERIOD && subi < m->window.size; subi += m->channels)
-			sub_avg += samples[i + chan];
-
-		bass += fabs(sub_avg / (SUB_PERIOD / m->channels));
+		case FADA_TSAMPLE_INT8:    return (channels == 1) ? &fada_kernels_i8_mono  : (channels == 2) ? &fada_kernels_i8_stereo  : &fada_kernels_i8;
+		case FADA_TSAMPLE_UINT8:   return (channels == 1) ? &fada_kernels_u8_mono  : (channels == 2) ? &fada_kernels_u8_stereo  : &fada_kernels_u8;
+		case FADA_TSAMPLE_INT16:   return (channels == 1) ? &fada_kernels_i16_mono : (channels == 2) ? &fada_kernels_i16_stereo : &fada_kernels_i16;
+		case FADA_TSAMPLE_INT24:   return (channels == 1) ? &fada_kernels_i24_mono : (channels == 2) ? &fada_kernels_i24_stereo : &fada_kernels_i24;
+		case FADA_TSAMPLE_INT32:   return (channels == 1) ? &fada_kernels_i32_mono : (channels == 2) ? &fada_kernels_i32_stereo : &fada_kernels_i32;
+		case FADA_TSAMPLE_INT64:   return (channels == 1) ? &fada_kernels_i64_mono : (channels == 2) ? &fada_kernels_i64_stereo : &fada_kernels_i64;
+		case FADA_TSAMPLE_FLOAT32: return (channels == 1) ? &fada_kernels_f32_mono : (channels == 2) ? &fada_kernels_f32_stereo : &fada_kernels_f32;
+		case FADA_TSAMPLE_FLOAT64: return (channels == 1) ? &fada_kernels_f64_mono : (channels == 2) ? &fada_kernels_f64_stereo : &fada_kernels_f64;
+		default: return NULL;
 	}
-
-	return bass / ((m->window.size / m->channels) / SUB_PERIOD);
 }
 
 
 //////////////////////////////////////////////////
-void fada_calcfft_i8(fada_Manager* m)
+void fada_slidewindow(fada_Manager* m, fada_Pos shift)
 {
-	unsigned int i, j, c, rate;
-	fada_Res normal, avg;
-	
-	const char* samples = (char*)m->window.buffer;
-	fada_Res* fft = m->fft.buffer->buffer;
-
-	fada_fillwindowbuffer_i8(m);
-	normal = fada_getnormalizer(m);
-
-	rate = m->fft.buffer->size;
-
-	for (i = 0, j = 0; i < rate; ++i, j += m->channels)
+	// Rescan every so often so rounding errors don't build up in the running sums.
+	if (++m->sums.slides >= _FADA_SUMS_REFRESH)
 	{
-		avg = 0.;
-		for (c = 0; c < m->channels; ++c)
-			avg += (j + c < m->window.size) ? (samples[j + c] / normal) : 0.;
-		fft[2*i] = avg / m->channels;
-		fft[2*i+1] = 0.;
+		m->sums.beat_valid = FADA_FALSE;
+		m->sums.bass_valid = FADA_FALSE;
+		m->sums.slides = 0;
 	}
 
-	fada_calcfft_master(fft, rate);
-}
-
-
-//////////////////////////////////////////////////
-void fada_calcfft_i16(fada_Manager* m)
-{
-	unsigned int i, j, c, rate;
-	fada_Res normal, avg;
-	
-	const short* samples = (short*)m->window.buffer;
-	fada_Res* fft = m->fft.buffer->buffer;
-
-	fada_fillwindowbuffer_i16(m);
-	normal = fada_getnormalizer(m);
-
-	rate = m->fft.buffer->size;
+	m->kernels->slidewindow(m, shift);
 
-	for (i = 0, j = 0; i < rate; ++i, j += m->channels)
-	{
-		avg = 0.;
-		for (c = 0; c < m->channels; ++c)
-			avg += (j + c < m->window.size) ? (samples[j + c] / normal) : 0.;
-		fft[2*i] = avg / m->channels;
-		fft[2*i+1] = 0.;
-	}
-
-	fada_calcfft_master(fft, rate);
+	// A staged window can be shifted in place rather than copied again.
+	if (m->window.samples == m->window.buffer)
+		m->window.shift = shift;
 }
 
 
 //////////////////////////////////////////////////
-void fada_calcfft_i32(fada_Manager* m)
+void fada_calcfft_master(fada_Res* fft, const fada_FFTPlan* plan)
 {
-	unsigned int i, j, c, rate;
-	fada_Res normal, avg;
-	
-	const int* samples = (int*)m->window.buffer;
-	fada_Res* fft = m->fft.buffer->buffer;
-
-	fada_fillwindowbuffer_i32(m);
-	normal = fada_getnormalizer(m);
+	unsigned int n, k;
+	unsigned int a, b;
+	const unsigned int* swaps;
+	const fada_Res* w;
+	fada_Res wr, wi, tempr;
+	fada_Res evr, evi, odr, odi, xr, xi;
 
-	rate = m->fft.buffer->size;
+	// The real input of n values is treated as n/2 complex values (even samples real, odd samples imaginary).
+	n = plan->size >> 1;
 
-	for (i = 0, j = 0; i < rate; ++i, j += m->channels)
+	if (!n)
 	{
-		avg = 0.;
-		for (c = 0; c < m->channels; ++c)
-			avg += (j + c < m->window.size) ? (samples[j + c] / normal) : 0.;
-		fft[2*i] = avg / m->channels;
-		fft[2*i+1] = 0.;
+		fft[1] = 0.;
+		return;
 	}
 
-	fada_calcfft_master(fft, rate);
-}
-
-
-//////////////////////////////////////////////////
-void fada_calcfft_i64(fada_Manager* m)
-{
-	unsigned int i, j, c, rate;
-	fada_Res normal, avg;
-	
-	const long long* samples = (long long*)m->window.buffer;
-	fada_Res* fft = m->fft.buffer->buffer;
-
-	fada_fillwindowbuffer_i64(m);
-	normal = fada_getnormalizer(m);
-
-	rate = m->fft.buffer->size;
-
-	for (i = 0, j = 0; i < rate; ++i, j += m->channels)
+	// Bit-reversal permutation using the plan's precomputed swap pairs.
+	swaps = plan->swaps;
+	for (k = 0; k < plan->swap_count; ++k)
 	{
-		avg = 0.;
-		for (c = 0; c < m->channels; ++c)
-			avg += (j + c < m->window.size) ? (samples[j + c] / normal) : 0.;
-		fft[2*i] = avg / m->channels;
-		fft[2*i+1] = 0.;
-	}
-
-	fada_calcfft_master(fft, rate);
-}
-
-
-//////////////////////////////////////////////////
-void fada_calcfft_f32(fada_Manager* m)
-{
-	unsigned int i, j, c, rate;
-	fada_Res avg;
-	
-	const float* samples = (float*)m->window.buffer;
-	fada_Res* fft = m->fft.buffer->buffer;
+		a = 2*swaps[2*k];
+		b = 2*swaps[2*k+1];
 
-	fada_fillwindowbuffer_f32(m);
-
-	rate = m->fft.buffer->size;
-
-	for (i = 0, j = 0; i < rate; ++i, j += m->channels)
-	{
-		avg = 0.;
-		for (c = 0; c < m->channels; ++c)
-			avg += (j + c < m->window.size) ? samples[j + c] : 0.;
-		fft[2*i] = avg / m->channels;
-		fft[2*i+1] = 0.;
+		_FADA_FFT_SWAP(fft[a], fft[b]);
+		_FADA_FFT_SWAP(fft[a+1], fft[b+1]);
 	}
 
-	fada_calcfft_master(fft, rate);
-}
-
-
-//////////////////////////////////////////////////
-void fada_calcfft_f64(fada_Manager* m)
-{
-	unsigned int i, j, c, rate;
-	fada_Res avg;
-	
-	const double* samples = (double*)m->window.buffer;
-	fada_Res* fft = m->fft.buffer->buffer;
+	// Butterflies using the plan's precomputed twiddle factors.
+	plan->butterflies(fft, plan->twiddles, n);
 
-	fada_fillwindowbuffer_f64(m);
+	// Split the half-size transform into the spectrum of the real input.
+	// Bins k and n-k are computed together from the even (ev) and odd (od) sample spectra, then mirrored
+	// as conjugates into the upper half so the buffer holds the same full spectrum a complex FFT would.
+	w = &plan->twiddles[2*n];
 
-	rate = m->fft.buffer->size;
+	evr = fft[0];
+	evi = fft[1];
+	fft[0]   = evr + evi;
+	fft[1]   = 0.;
+	fft[2*n]   = evr - evi;
+	fft[2*n+1] = 0.;
 
-	for (i = 0, j = 0; i < rate; ++i, j += m->channels)
+	for (k = 1; k <= n - k; ++k)
 	{
-		avg = 0.;
-		for (c = 0; c < m->channels; ++c)
-			avg += (j + c < m->window.size) ? samples[j + c] : 0.;
-		fft[2*i] = avg / m->channels;
-		fft[2*i+1] = 0.;
-	}
-
-	fada_calcfft_master(fft, rate);
-}
-
+		a = 2*k;
+		b = 2*(n - k);
 
-//////////////////////////////////////////////////
-void fada_calcfft_channel_i8(fada_Manager* m, unsigned int chan)
-{
-	unsigned int i, j, rate;
-	fada_Res normal;
+		evr = (fft[a] + fft[b]) * 0.5;
+		evi = (fft[a+1] - fft[b+1]) * 0.5;
+		odr = (fft[a+1] + fft[b+1]) * 0.5;
+		odi = (fft[b] - fft[a]) * 0.5;
 
-	const char* samples = (char*)m->window.buffer;
-	fada_Res* fft = m->fft.buffer->buffer;
+		wr = w[2*k];
+		wi = w[2*k+1];
 
-	fada_fillwindowbuffer_i8(m);
-	normal = fada_getnormalizer(m);
+		xr = wr*odr - wi*odi;
+		xi = wr*odi + wi*odr;
 
-	rate = m->fft.buffer->size;
+		fft[a]   = evr + xr;
+		fft[a+1] = evi + xi;
+		fft[b]   = evr - xr;
+		fft[b+1] = xi - evi;
 
-	for (i = 0, j = 0; i < rate; ++i, j += m->channels)
-	{
-		fft[2*i] = (j + chan < m->window.size) ? (samples[j + chan] / normal) : 0.;
-		fft[2*i+1] = 0.;
+		fft[4*n-a]   =  fft[a];
+		fft[4*n-a+1] = -fft[a+1];
+		fft[4*n-b]   =  fft[b];
+		fft[4*n-b+1] = -fft[b+1];
 	}
-	
-	fada_calcfft_master(fft, rate);
 }
 
 
 //////////////////////////////////////////////////
-void fada_calcfft_channel_i16(fada_Manager* m, unsigned int chan)
+void fada_calcfft32_master(float* fft, const fada_FFTPlan* plan)
 {
-	unsigned int i, j, rate;
-	fada_Res normal;
-
-	const short* samples = (short*)m->window.buffer;
-	fada_Res* fft = m->fft.buffer->buffer;
+	unsigned int n, k;
+	unsigned int a, b;
+	const unsigned int* swaps;
+	const float* w;
+	float wr, wi, tempr;
+	float evr, evi, odr, odi, xr, xi;
 
-	fada_fillwindowbuffer_i16(m);
-	normal = fada_getnormalizer(m);
+	// Single-precision version of fada_calcfft_master.
+	n = plan->size >> 1;
 
-	rate = m->fft.buffer->size;
-
-	for (i = 0, j = 0; i < m->fft.buffer->size; ++i, j += m->channels)
+	if (!n)
 	{
-		fft[2*i] = (j + chan < m->window.size) ? (samples[j + chan] / normal) : 0.;
-		fft[2*i+1] = 0.;
+		fft[1] = 0.f;
+		return;
 	}
-	
-	fada_calcfft_master(fft, rate);
-}
-
-
-//////////////////////////////////////////////////
-void fada_calcfft_channel_i32(fada_Manager* m, unsigned int chan)
-{
-	unsigned int i, j, rate;
-	fada_Res normal;
-
-	const int* samples = (int*)m->window.buffer;
-	fada_Res* fft = m->fft.buffer->buffer;
 
-	fada_fillwindowbuffer_i32(m);
-	normal = fada_getnormalizer(m);
-
-	rate = m->fft.buffer->size;
-
-	for (i = 0, j = 0; i < m->fft.buffer->size; ++i, j += m->channels)
+	// Bit-reversal permutation.
+	swaps = plan->swaps;
+	for (k = 0; k < plan->swap_count; ++k)
 	{
-		fft[2*i] = (j + chan < m->window.size) ? (samples[j + chan] / normal) : 0.;
-		fft[2*i+1] = 0.;
-	}
-	
-	fada_calcfft_master(fft, rate);
-}
-
-
-//////////////////////////////////////////////////
-void fada_calcfft_channel_i64(fada_Manager* m, unsigned int chan)
-{
-	unsigned int i, j, rate;
-	fada_Res normal;
+		a = 2*swaps[2*k];
+		b = 2*swaps[2*k+1];
 
-	const long long* samples = (long long*)m->window.buffer;
-	fada_Res* fft = m->fft.buffer->buffer;
-
-	fada_fillwindowbuffer_i64(m);
-	normal = fada_getnormalizer(m);
-
-	rate = m->fft.buffer->size;
-
-	for (i = 0, j = 0; i < m->fft.buffer->size; ++i, j += m->channels)
-	{
-		fft[2*i] = (j + chan < m->window.size) ? (samples[j + chan] / normal) : 0.;
-		fft[2*i+1] = 0.;
+		_FADA_FFT_SWAP(fft[a], fft[b]);
+		_FADA_FFT_SWAP(fft[a+1], fft[b+1]);
 	}
-	
-	fada_calcfft_master(fft, rate);
-}
-
-
-//////////////////////////////////////////////////
-void fada_calcfft_channel_f32(fada_Manager* m, unsigned int chan)
-{
-	unsigned int i, j, rate;
 
-	const float* samples = (float*)m->window.buffer;
-	fada_Res* fft = m->fft.buffer->buffer;
+	// Butterflies.
+	plan->butterflies32(fft, plan->twiddles32, n);
 
-	fada_fillwindowbuffer_f32(m);
+	// Split the half-size transform into the spectrum of the real input.
+	w = &plan->twiddles32[2*n];
 
-	rate = m->fft.buffer->size;
+	evr = fft[0];
+	evi = fft[1];
+	fft[0]   = evr + evi;
+	fft[1]   = 0.;
+	fft[2*n]   = evr - evi;
+	fft[2*n+1] = 0.f;
 
-	for (i = 0, j = 0; i < m->fft.buffer->size; ++i, j += m->channels)
+	for (k = 1; k <= n - k; ++k)
 	{
-		fft[2*i] = (j + chan < m->window.size) ? samples[j + chan] : 0.;
-		fft[2*i+1] = 0.;
-	}
-	
-	fada_calcfft_master(fft, rate);
-}
-
-
-//////////////////////////////////////////////////
-void fada_calcfft_channel_f64(fada_Manager* m, unsigned int chan)
-{
-	unsigned int i, j, rate;
-
-	const double* samples = (double*)m->window.buffer;
-	fada_Res* fft = m->fft.buffer->buffer;
+		a = 2*k;
+		b = 2*(n - k);
 
-	fada_fillwindowbuffer_f64(m);
+		evr = (fft[a] + fft[b]) * 0.5f;
+		evi = (fft[a+1] - fft[b+1]) * 0.5f;
+		odr = (fft[a+1] + fft[b+1]) * 0.5f;
+		odi = (fft[b] - fft[a]) * 0.5f;
 
-	rate = m->fft.buffer->size;
+		wr = w[2*k];
+		wi = w[2*k+1];
 
-	for (i = 0, j = 0; i < m->fft.buffer->size; ++i, j += m->channels)
-	{
-		fft[2*i] = (j + chan < m->window.size) ? samples[j + chan] : 0.;
-		fft[2*i+1] = 0.;
-	}
-	
-	fada_calcfft_master(fft, rate);
-}
+		xr = wr*odr - wi*odi;
+		xi = wr*odi + wi*odr;
 
+		fft[a]   = evr + xr;
+		fft[a+1] = evi + xi;
+		fft[b]   = evr - xr;
+		fft[b+1] = xi - evi;
 
-//////////////////////////////////////////////////
-void fada_calcfft_master(fada_Res* fft, unsigned int rate)
-{
-	unsigned int n, mmax, mm;
-	unsigned int i, j, is;
-	double wtemp, wr, wpr, wpi, wi, theta;
-	fada_Res tempi, tempr;
-
-	n = rate << 1;
-	j = 0;
-	mmax = n / 2;
-	for (i = 0; i < mmax; i += 2)
-	{
-		if (j > i)
-		{
-			_FADA_FFT_SWAP(fft[j], fft[i]);
-			_FADA_FFT_SWAP(fft[j+1], fft[i+1]);
-			if ((j/2) < (n/4))
-			{
-				_FADA_FFT_SWAP(fft[(n-(i+2))], fft[(n-(j+2))]);
-				_FADA_FFT_SWAP(fft[(n-(i+2))+1], fft[(n-(j+2))+1]);
-			}
-		}
-		mm = n >> 1;
-		while (mm >= 2 && j >= mm)
-		{
-			j -= mm;
-			mm >>= 1;
-		}
-		j += mm;
-	}
-	
-	mmax = 2;
-	while (n > mmax)
-	{
-		is = mmax << 1;
-		theta = (2.*_FADA_PI/mmax);
-		wtemp = sin(0.5*theta);
-		wpr = -2.*wtemp*wtemp;
-		wpi = sin(theta);
-		wr = 1.;
-		wi = 0.;
-		for (mm = 1; mm < mmax; mm += 2)
-		{
-			for (i = mm; i <= n; i += is)
-			{
-				j = i + mmax;
-
-				tempr = wr*fft[j-1]-wi*fft[j];
-				tempi = wr*fft[j]+wi*fft[j-1];
-
-				fft[j-1] = fft[i-1]-tempr;
-				fft[j] = fft[i]-tempi;
-				fft[i-1] += tempr;
-				fft[i] += tempi;
-			}
-			wr = (wtemp=wr)*wpr - wi*wpi + wr;
-			wi = wi*wpr + wtemp*wpi + wi;
-		}
-		mmax = is;
+		fft[4*n-a]   =  fft[a];
+		fft[4*n-a+1] = -fft[a+1];
+		fft[4*n-b]   =  fft[b];
+		fft[4*n-b+1] = -fft[b+1];
 	}
 }
\ No newline at end of file
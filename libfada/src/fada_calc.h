@@ -29,83 +29,39 @@
 #include <fada/fada_def.h>
 
 
-void fada_fillwindowbuffer_i8(fada_Manager* m);
-void fada_fillwindowbuffer_i16(fada_Manager* m);
-void fada_fillwindowbuffer_i32(fada_Manager* m);
-void fada_fillwindowbuffer_i64(fada_Manager* m);
-void fada_fillwindowbuffer_f32(fada_Manager* m);
-void fada_fillwindowbuffer_f64(fada_Manager* m);
+// Analysis kernels for one sample type and channel layout.
+// The manager resolves its table once when audio is bound, so calculations don't need to switch on the sample type.
+typedef struct fada_Kernels fada_Kernels;
 
-fada_Res fada_getsample_i8(fada_Manager* m, fada_Pos pos);
-fada_Res fada_getsample_i16(fada_Manager* m, fada_Pos pos);
-fada_Res fada_getsample_i32(fada_Manager* m, fada_Pos pos);
-fada_Res fada_getsample_i64(fada_Manager* m, fada_Pos pos);
-fada_Res fada_getsample_f32(fada_Manager* m, fada_Pos pos);
-fada_Res fada_getsample_f64(fada_Manager* m, fada_Pos pos);
+struct fada_Kernels
+{
+	void (*slidewindow)(fada_Manager* m, fada_Pos shift);
 
-void fada_getsamples_i8(fada_Manager* m, unsigned int channel, fada_Res* out_results);
-void fada_getsamples_i16(fada_Manager* m, unsigned int channel, fada_Res* out_results);
-void fada_getsamples_i32(fada_Manager* m, unsigned int channel, fada_Res* out_results);
-void fada_getsamples_i64(fada_Manager* m, unsigned int channel, fada_Res* out_results);
-void fada_getsamples_f32(fada_Manager* m, unsigned int channel, fada_Res* out_results);
-void fada_getsamples_f64(fada_Manager* m, unsigned int channel, fada_Res* out_results);
+	fada_Res (*getsample)(fada_Manager* m, fada_Pos pos);
+	void (*getsamples)(fada_Manager* m, unsigned int channel, fada_Res* out_results);
+	fada_Res (*getframe)(fada_Manager* m, fada_Pos pos);
+	void (*getframes)(fada_Manager* m, fada_Res* out_results);
 
-fada_Res fada_getframe_i8(fada_Manager* m, fada_Pos pos);
-fada_Res fada_getframe_i16(fada_Manager* m, fada_Pos pos);
-fada_Res fada_getframe_i32(fada_Manager* m, fada_Pos pos);
-fada_Res fada_getframe_i64(fada_Manager* m, fada_Pos pos);
-fada_Res fada_getframe_f32(fada_Manager* m, fada_Pos pos);
-fada_Res fada_getframe_f64(fada_Manager* m, fada_Pos pos);
+	fada_Res (*calcbeat)(fada_Manager* m);
+	fada_Res (*calcbeat_channel)(fada_Manager* m, unsigned int chan);
+	fada_Res (*calcbass)(fada_Manager* m);
+	fada_Res (*calcbass_channel)(fada_Manager* m, unsigned int chan);
 
-void fada_getframes_i8(fada_Manager* m, fada_Res* out_results);
-void fada_getframes_i16(fada_Manager* m, fada_Res* out_results);
-void fada_getframes_i32(fada_Manager* m, fada_Res* out_results);
-void fada_getframes_i64(fada_Manager* m, fada_Res* out_results);
-void fada_getframes_f32(fada_Manager* m, fada_Res* out_results);
-void fada_getframes_f64(fada_Manager* m, fada_Res* out_results);
+	void (*calcfft)(fada_Manager* m);
+	void (*calcfft_channel)(fada_Manager* m, unsigned int chan);
+	void (*calcfft32)(fada_Manager* m);
+	void (*calcfft32_channel)(fada_Manager* m, unsigned int chan);
+	void (*calcfft_allchannels)(fada_Manager* m, fada_FFTBuffer** buffers);
 
-fada_Res fada_calcbeat_i8(fada_Manager* m);
-fada_Res fada_calcbeat_i16(fada_Manager* m);
-fada_Res fada_calcbeat_i32(fada_Manager* m);
-fada_Res fada_calcbeat_i64(fada_Manager* m);
-fada_Res fada_calcbeat_f32(fada_Manager* m);
-fada_Res fada_calcbeat_f64(fada_Manager* m);
+	void (*calcfeatures)(fada_Manager* m, fada_Feature features, fada_Res* out_beat, fada_Res* out_bass, fada_Res* out_frames);
+};
 
-fada_Res fada_calcbeat_channel_i8(fada_Manager* m, unsigned int chan);
-fada_Res fada_calcbeat_channel_i16(fada_Manager* m, unsigned int chan);
-fada_Res fada_calcbeat_channel_i32(fada_Manager* m, unsigned int chan);
-fada_Res fada_calcbeat_channel_i64(fada_Manager* m, unsigned int chan);
-fada_Res fada_calcbeat_channel_f32(fada_Manager* m, unsigned int chan);
-fada_Res fada_calcbeat_channel_f64(fada_Manager* m, unsigned int chan);
+// Returns NULL if the sample type is not supported.
+const fada_Kernels* fada_getkernels(fada_TSample type, unsigned int channels);
 
-fada_Res fada_calcbass_i8(fada_Manager* m);
-fada_Res fada_calcbass_i16(fada_Manager* m);
-fada_Res fada_calcbass_i32(fada_Manager* m);
-fada_Res fada_calcbass_i64(fada_Manager* m);
-fada_Res fada_calcbass_f32(fada_Manager* m);
-fada_Res fada_calcbass_f64(fada_Manager* m);
+void fada_slidewindow(fada_Manager* m, fada_Pos shift);
 
-fada_Res fada_calcbass_channel_i8(fada_Manager* m, unsigned int chan);
-fada_Res fada_calcbass_channel_i16(fada_Manager* m, unsigned int chan);
-fada_Res fada_calcbass_channel_i32(fada_Manager* m, unsigned int chan);
-fada_Res fada_calcbass_channel_i64(fada_Manager* m, unsigned int chan);
-fada_Res fada_calcbass_channel_f32(fada_Manager* m, unsigned int chan);
-fada_Res fada_calcbass_channel_f64(fada_Manager* m, unsigned int chan);
-
-void fada_calcfft_i8(fada_Manager* m);
-void fada_calcfft_i16(fada_Manager* m);
-void fada_calcfft_i32(fada_Manager* m);
-void fada_calcfft_i64(fada_Manager* m);
-void fada_calcfft_f32(fada_Manager* m);
-void fada_calcfft_f64(fada_Manager* m);
-
-void fada_calcfft_channel_i8(fada_Manager* m, unsigned int chan);
-void fada_calcfft_channel_i16(fada_Manager* m, unsigned int chan);
-void fada_calcfft_channel_i32(fada_Manager* m, unsigned int chan);
-void fada_calcfft_channel_i64(fada_Manager* m, unsigned int chan);
-void fada_calcfft_channel_f32(fada_Manager* m, unsigned int chan);
-void fada_calcfft_channel_f64(fada_Manager* m, unsigned int chan);
-
-void fada_calcfft_master(fada_Res* fft, unsigned int rate);
+void fada_calcfft_master(fada_Res* fft, const fada_FFTPlan* plan);
+void fada_calcfft32_master(float* fft, const fada_FFTPlan* plan);
 
 #endif
\ No newline at end of file
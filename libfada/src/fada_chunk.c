@@ -35,16 +35,24 @@ fada_Chunk* fada_newchunk()
 	if (!chunk)
 		return NULL;
 
+	fada_resetchunk(chunk);
+
+	return chunk;
+}
+
+
+//////////////////////////////////////////////////
+void fada_resetchunk(fada_Chunk* chunk)
+{
 	chunk->next = NULL;
 	chunk->prev = NULL;
 
 	chunk->samples = NULL;
 	chunk->samples_copied = FADA_FALSE;
+	chunk->samples_size = 0;
 	chunk->sample_count = 0;
 
 	chunk->position = 0;
-
-	return chunk;
 }
 
 
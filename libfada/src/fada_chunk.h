@@ -36,6 +36,7 @@ struct fada_Chunk
 	void* samples;
 	fada_Pos sample_count;
 	fada_Boolean samples_copied;
+	fada_Pos samples_size;
 
 	fada_Pos position;
 
@@ -44,6 +45,7 @@ struct fada_Chunk
 };
 
 fada_Chunk* fada_newchunk();
+void fada_resetchunk(fada_Chunk* chunk);
 void fada_closechunk(fada_Chunk* chunk);
 
 #endif
\ No newline at end of file
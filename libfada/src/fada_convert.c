@@ -0,0 +1,730 @@
+/***********************************************************************************
+ * libfada - Free Audio Detection and Analyzation Library                          *
+ *                                                                                 *
+ * The zlib/libpng License                                                         *
+ * Copyright (c) 2013 Nathan Cousins                                               *
+ *                                                                                 *
+ * This software is provided 'as-is', without any express or implied warranty.     *
+ * In no event will the authors be held liable for any damages arising from the    *
+ * use of this software.                                                           *
+ *                                                                                 *
+ * Permission is granted to anyone to use this software for any purpose,           *
+ * including commercial applications, and to alter it and redistribute it freely,  *
+ * subject to the following restrictions:                                          *
+ *                                                                                 *
+ * 1. The origin of this software must not be misrepresented; you must not claim   *
+ *    that you wrote the original software. If you use this software in a product, *
+ *    an acknowledgment in the product documentation would be appreciated but is   *
+ *    not required.                                                                *
+ *                                                                                 *
+ * 2. Altered source versions must be plainly marked as such, and must not be      *
+ *    misrepresented as being the original software.                               *
+ *                                                                                 *
+ * 3. This notice may not be removed or altered from any source distribution.      *
+ ***********************************************************************************/
+
+#include "fada_convert.h"
+#include "fada_fft.h"
+
+
+// Portable converters. These define the results; the vectorized versions below must match them exactly.
+// V turns a stored sample into its value.
+#define _FADA_CONVERT_VALUE(x) (x)
+
+#define _FADA_CONVERT_SCALAR(id, T, V) \
+	static void fada_mix_##id(const void* samples, unsigned int channels, fada_Pos frames, fada_Res scale, fada_Res* out) \
+	{ \
+		const T* in = (const T*)samples; \
+		fada_Pos f; \
+		unsigned int c; \
+		fada_Res sum; \
+		\
+		for (f = 0; f < frames; ++f, in += channels) \
+		{ \
+			sum = 0.; \
+			for (c = 0; c < channels; ++c) \
+				sum += (fada_Res)V(in[c]); \
+			out[f] = sum * scale; \
+		} \
+	} \
+	\
+	static void fada_mix32_##id(const void* samples, unsigned int channels, fada_Pos frames, float scale, float* out) \
+	{ \
+		const T* in = (const T*)samples; \
+		fada_Pos f; \
+		unsigned int c; \
+		float sum; \
+		\
+		for (f = 0; f < frames; ++f, in += channels) \
+		{ \
+			sum = 0.f; \
+			for (c = 0; c < channels; ++c) \
+				sum += (float)V(in[c]); \
+			out[f] = sum * scale; \
+		} \
+	} \
+	\
+	static void fada_extract_##id(const void* samples, unsigned int channels, unsigned int chan, fada_Pos frames, fada_Res scale, fada_Res* out) \
+	{ \
+		const T* in = (const T*)samples + chan; \
+		fada_Pos f; \
+		\
+		for (f = 0; f < frames; ++f, in += channels) \
+			out[f] = (fada_Res)V(*in) * scale; \
+	} \
+	\
+	static void fada_extract32_##id(const void* samples, unsigned int channels, unsigned int chan, fada_Pos frames, float scale, float* out) \
+	{ \
+		const T* in = (const T*)samples + chan; \
+		fada_Pos f; \
+		\
+		for (f = 0; f < frames; ++f, in += channels) \
+			out[f] = (float)V(*in) * scale; \
+	} \
+	\
+	static void fada_deinterleave_##id(const void* samples, unsigned int channels, fada_Pos frames, fada_Res scale, fada_Res* const* outs) \
+	{ \
+		const T* in = (const T*)samples; \
+		fada_Pos f; \
+		unsigned int c; \
+		\
+		for (f = 0; f < frames; ++f, in += channels) \
+			for (c = 0; c < channels; ++c) \
+				outs[c][f] = (fada_Res)V(in[c]) * scale; \
+	} \
+	\
+	static void fada_deinterleave32_##id(const void* samples, unsigned int channels, fada_Pos frames, float scale, float* const* outs) \
+	{ \
+		const T* in = (const T*)samples; \
+		fada_Pos f; \
+		unsigned int c; \
+		\
+		for (f = 0; f < frames; ++f, in += channels) \
+			for (c = 0; c < channels; ++c) \
+				outs[c][f] = (float)V(in[c]) * scale; \
+	} \
+	\
+	static const fada_Converters fada_converters_##id = { fada_mix_##id, fada_mix32_##id, fada_extract_##id, fada_extract32_##id, fada_deinterleave_##id, fada_deinterleave32_##id };
+
+_FADA_CONVERT_SCALAR(i8, char, _FADA_CONVERT_VALUE)
+_FADA_CONVERT_SCALAR(u8, unsigned char, fada_uint8value)
+_FADA_CONVERT_SCALAR(i16, short, _FADA_CONVERT_VALUE)
+_FADA_CONVERT_SCALAR(i24, fada_Int24, fada_int24value)
+_FADA_CONVERT_SCALAR(i32, int, _FADA_CONVERT_VALUE)
+_FADA_CONVERT_SCALAR(i64, long long, _FADA_CONVERT_VALUE)
+_FADA_CONVERT_SCALAR(f32, float, _FADA_CONVERT_VALUE)
+_FADA_CONVERT_SCALAR(f64, double, _FADA_CONVERT_VALUE)
+
+// Packed samples are addressed as an array of fada_Int24, which must not be padded.
+typedef char fada_checkint24size[(sizeof(fada_Int24) == 3) ? 1 : -1];
+
+
+#ifdef _FADA_SIMD_X86
+
+// The vectorized converters handle mono and stereo, and leave other channel counts and the last few frames to the portable ones.
+
+//////////////////////////////////////////////////
+_FADA_TARGET("sse2") static void fada_store4_sse2(fada_Res* out, __m128i x, __m128d scale)
+{
+	_mm_storeu_pd(&out[0], _mm_mul_pd(_mm_cvtepi32_pd(x), scale));
+	_mm_storeu_pd(&out[2], _mm_mul_pd(_mm_cvtepi32_pd(_mm_shuffle_epi32(x, 0xEE)), scale));
+}
+
+
+//////////////////////////////////////////////////
+_FADA_TARGET("sse2") static void fada_mix_i16_sse2(const void* samples, unsigned int channels, fada_Pos frames, fada_Res scale, fada_Res* out)
+{
+	const short* in = (const short*)samples;
+	const __m128d s = _mm_set1_pd(scale);
+	__m128i x;
+	fada_Pos f = 0;
+
+	if (channels == 1)
+	{
+		for (; f + 8 <= frames; f += 8)
+		{
+			x = _mm_loadu_si128((const __m128i*)&in[f]);
+			fada_store4_sse2(&out[f], _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16), s);
+			fada_store4_sse2(&out[f+4], _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16), s);
+		}
+	}
+	else if (channels == 2)
+	{
+		// Multiply-add by one sums the two channels of each frame exactly.
+		for (; f + 4 <= frames; f += 4)
+		{
+			x = _mm_madd_epi16(_mm_loadu_si128((const __m128i*)&in[2*f]), _mm_set1_epi16(1));
+			fada_store4_sse2(&out[f], x, s);
+		}
+	}
+
+	fada_mix_i16(&in[f * channels], channels, frames - f, scale, &out[f]);
+}
+
+
+//////////////////////////////////////////////////
+_FADA_TARGET("sse2") static void fada_mix32_i16_sse2(const void* samples, unsigned int channels, fada_Pos frames, float scale, float* out)
+{
+	const short* in = (const short*)samples;
+	const __m128 s = _mm_set1_ps(scale);
+	__m128i x;
+	fada_Pos f = 0;
+
+	if (channels == 1)
+	{
+		for (; f + 8 <= frames; f += 8)
+		{
+			x = _mm_loadu_si128((const __m128i*)&in[f]);
+			_mm_storeu_ps(&out[f], _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16)), s));
+			_mm_storeu_ps(&out[f+4], _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16)), s));
+		}
+	}
+	else if (channels == 2)
+	{
+		for (; f + 4 <= frames; f += 4)
+		{
+			x = _mm_madd_epi16(_mm_loadu_si128((const __m128i*)&in[2*f]), _mm_set1_epi16(1));
+			_mm_storeu_ps(&out[f], _mm_mul_ps(_mm_cvtepi32_ps(x), s));
+		}
+	}
+
+	fada_mix32_i16(&in[f * channels], channels, frames - f, scale, &out[f]);
+}
+
+
+//////////////////////////////////////////////////
+_FADA_TARGET("sse2") static void fada_extract_i16_sse2(const void* samples, unsigned int channels, unsigned int chan, fada_Pos frames, fada_Res scale, fada_Res* out)
+{
+	const short* in = (const short*)samples;
+	const __m128d s = _mm_set1_pd(scale);
+	__m128i x;
+	fada_Pos f = 0;
+
+	if (channels == 1)
+	{
+		fada_mix_i16_sse2(samples, channels, frames, scale, out);
+		return;
+	}
+
+	if (channels == 2)
+	{
+		for (; f + 4 <= frames; f += 4)
+		{
+			x = _mm_loadu_si128((const __m128i*)&in[2*f]);
+			x = chan ? _mm_srai_epi32(x, 16) : _mm_srai_epi32(_mm_slli_epi32(x, 16), 16);
+			fada_store4_sse2(&out[f], x, s);
+		}
+	}
+
+	fada_extract_i16(&in[f * channels], channels, chan, frames - f, scale, &out[f]);
+}
+
+
+//////////////////////////////////////////////////
+_FADA_TARGET("sse2") static void fada_extract32_i16_sse2(const void* samples, unsigned int channels, unsigned int chan, fada_Pos frames, float scale, float* out)
+{
+	const short* in = (const short*)samples;
+	const __m128 s = _mm_set1_ps(scale);
+	__m128i x;
+	fada_Pos f = 0;
+
+	if (channels == 1)
+	{
+		fada_mix32_i16_sse2(samples, channels, frames, scale, out);
+		return;
+	}
+
+	if (channels == 2)
+	{
+		for (; f + 4 <= frames; f += 4)
+		{
+			x = _mm_loadu_si128((const __m128i*)&in[2*f]);
+			x = chan ? _mm_srai_epi32(x, 16) : _mm_srai_epi32(_mm_slli_epi32(x, 16), 16);
+			_mm_storeu_ps(&out[f], _mm_mul_ps(_mm_cvtepi32_ps(x), s));
+		}
+	}
+
+	fada_extract32_i16(&in[f * channels], channels, chan, frames - f, scale, &out[f]);
+}
+
+//////////////////////////////////////////////////
+_FADA_TARGET("sse2") static void fada_deinterleave_i16_sse2(const void* samples, unsigned int channels, fada_Pos frames, fada_Res scale, fada_Res* const* outs)
+{
+	const short* in = (const short*)samples;
+	const __m128d s = _mm_set1_pd(scale);
+	fada_Res* tail[2];
+	__m128i x;
+	fada_Pos f;
+
+	if (channels == 1)
+	{
+		fada_mix_i16_sse2(samples, channels, frames, scale, outs[0]);
+		return;
+	}
+
+	if (channels != 2)
+	{
+		fada_deinterleave_i16(samples, channels, frames, scale, outs);
+		return;
+	}
+
+	for (f = 0; f + 4 <= frames; f += 4)
+	{
+		x = _mm_loadu_si128((const __m128i*)&in[2*f]);
+		fada_store4_sse2(&outs[0][f], _mm_srai_epi32(_mm_slli_epi32(x, 16), 16), s);
+		fada_store4_sse2(&outs[1][f], _mm_srai_epi32(x, 16), s);
+	}
+
+	tail[0] = &outs[0][f];
+	tail[1] = &outs[1][f];
+	fada_deinterleave_i16(&in[2*f], 2, frames - f, scale, tail);
+}
+
+
+//////////////////////////////////////////////////
+_FADA_TARGET("sse2") static void fada_deinterleave32_i16_sse2(const void* samples, unsigned int channels, fada_Pos frames, float scale, float* const* outs)
+{
+	const short* in = (const short*)samples;
+	const __m128 s = _mm_set1_ps(scale);
+	float* tail[2];
+	__m128i x;
+	fada_Pos f;
+
+	if (channels == 1)
+	{
+		fada_mix32_i16_sse2(samples, channels, frames, scale, outs[0]);
+		return;
+	}
+
+	if (channels != 2)
+	{
+		fada_deinterleave32_i16(samples, channels, frames, scale, outs);
+		return;
+	}
+
+	for (f = 0; f + 4 <= frames; f += 4)
+	{
+		x = _mm_loadu_si128((const __m128i*)&in[2*f]);
+		_mm_storeu_ps(&outs[0][f], _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(x, 16), 16)), s));
+		_mm_storeu_ps(&outs[1][f], _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(x, 16)), s));
+	}
+
+	tail[0] = &outs[0][f];
+	tail[1] = &outs[1][f];
+	fada_deinterleave32_i16(&in[2*f], 2, frames - f, scale, tail);
+}
+
+
+
+//////////////////////////////////////////////////
+_FADA_TARGET("sse2") static void fada_mix_i32_sse2(const void* samples, unsigned int channels, fada_Pos frames, fada_Res scale, fada_Res* out)
+{
+	const int* in = (const int*)samples;
+	const __m128d s = _mm_set1_pd(scale);
+	__m128i x;
+	__m128d a, b;
+	fada_Pos f = 0;
+
+	if (channels == 1)
+	{
+		for (; f + 4 <= frames; f += 4)
+			fada_store4_sse2(&out[f], _mm_loadu_si128((const __m128i*)&in[f]), s);
+	}
+	else if (channels == 2)
+	{
+		// The channels are summed as doubles, since the sum may not fit 32 bits.
+		for (; f + 2 <= frames; f += 2)
+		{
+			x = _mm_loadu_si128((const __m128i*)&in[2*f]);
+			a = _mm_cvtepi32_pd(x);
+			b = _mm_cvtepi32_pd(_mm_shuffle_epi32(x, 0xEE));
+			_mm_storeu_pd(&out[f], _mm_mul_pd(_mm_add_pd(_mm_unpacklo_pd(a, b), _mm_unpackhi_pd(a, b)), s));
+		}
+	}
+
+	fada_mix_i32(&in[f * channels], channels, frames - f, scale, &out[f]);
+}
+
+
+//////////////////////////////////////////////////
+_FADA_TARGET("sse2") static void fada_mix32_i32_sse2(const void* samples, unsigned int channels, fada_Pos frames, float scale, float* out)
+{
+	const int* in = (const int*)samples;
+	const __m128 s = _mm_set1_ps(scale);
+	__m128 a, b;
+	fada_Pos f = 0;
+
+	if (channels == 1)
+	{
+		for (; f + 4 <= frames; f += 4)
+			_mm_storeu_ps(&out[f], _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)&in[f])), s));
+	}
+	else if (channels == 2)
+	{
+		for (; f + 4 <= frames; f += 4)
+		{
+			a = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)&in[2*f]));
+			b = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)&in[2*f+4]));
+			_mm_storeu_ps(&out[f], _mm_mul_ps(_mm_add_ps(_mm_shuffle_ps(a, b, 0x88), _mm_shuffle_ps(a, b, 0xDD)), s));
+		}
+	}
+
+	fada_mix32_i32(&in[f * channels], channels, frames - f, scale, &out[f]);
+}
+
+
+//////////////////////////////////////////////////
+_FADA_TARGET("sse2") static void fada_extract_i32_sse2(const void* samples, unsigned int channels, unsigned int chan, fada_Pos frames, fada_Res scale, fada_Res* out)
+{
+	const int* in = (const int*)samples;
+	const __m128d s = _mm_set1_pd(scale);
+	__m128i x;
+	fada_Pos f = 0;
+
+	if (channels == 1)
+	{
+		fada_mix_i32_sse2(samples, channels, frames, scale, out);
+		return;
+	}
+
+	if (channels == 2)
+	{
+		for (; f + 2 <= frames; f += 2)
+		{
+			x = _mm_loadu_si128((const __m128i*)&in[2*f]);
+			x = chan ? _mm_shuffle_epi32(x, 0x0D) : _mm_shuffle_epi32(x, 0x08);
+			_mm_storeu_pd(&out[f], _mm_mul_pd(_mm_cvtepi32_pd(x), s));
+		}
+	}
+
+	fada_extract_i32(&in[f * channels], channels, chan, frames - f, scale, &out[f]);
+}
+
+
+//////////////////////////////////////////////////
+_FADA_TARGET("sse2") static void fada_extract32_i32_sse2(const void* samples, unsigned int channels, unsigned int chan, fada_Pos frames, float scale, float* out)
+{
+	const int* in = (const int*)samples;
+	const __m128 s = _mm_set1_ps(scale);
+	__m128 a, b;
+	fada_Pos f = 0;
+
+	if (channels == 1)
+	{
+		fada_mix32_i32_sse2(samples, channels, frames, scale, out);
+		return;
+	}
+
+	if (channels == 2)
+	{
+		for (; f + 4 <= frames; f += 4)
+		{
+			a = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)&in[2*f]));
+			b = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)&in[2*f+4]));
+			a = chan ? _mm_shuffle_ps(a, b, 0xDD) : _mm_shuffle_ps(a, b, 0x88);
+			_mm_storeu_ps(&out[f], _mm_mul_ps(a, s));
+		}
+	}
+
+	fada_extract32_i32(&in[f * channels], channels, chan, frames - f, scale, &out[f]);
+}
+
+//////////////////////////////////////////////////
+_FADA_TARGET("sse2") static void fada_deinterleave_i32_sse2(const void* samples, unsigned int channels, fada_Pos frames, fada_Res scale, fada_Res* const* outs)
+{
+	const int* in = (const int*)samples;
+	const __m128d s = _mm_set1_pd(scale);
+	fada_Res* tail[2];
+	__m128i x;
+	fada_Pos f;
+
+	if (channels == 1)
+	{
+		fada_mix_i32_sse2(samples, channels, frames, scale, outs[0]);
+		return;
+	}
+
+	if (channels != 2)
+	{
+		fada_deinterleave_i32(samples, channels, frames, scale, outs);
+		return;
+	}
+
+	for (f = 0; f + 2 <= frames; f += 2)
+	{
+		x = _mm_loadu_si128((const __m128i*)&in[2*f]);
+		_mm_storeu_pd(&outs[0][f], _mm_mul_pd(_mm_cvtepi32_pd(_mm_shuffle_epi32(x, 0x08)), s));
+		_mm_storeu_pd(&outs[1][f], _mm_mul_pd(_mm_cvtepi32_pd(_mm_shuffle_epi32(x, 0x0D)), s));
+	}
+
+	tail[0] = &outs[0][f];
+	tail[1] = &outs[1][f];
+	fada_deinterleave_i32(&in[2*f], 2, frames - f, scale, tail);
+}
+
+
+//////////////////////////////////////////////////
+_FADA_TARGET("sse2") static void fada_deinterleave32_i32_sse2(const void* samples, unsigned int channels, fada_Pos frames, float scale, float* const* outs)
+{
+	const int* in = (const int*)samples;
+	const __m128 s = _mm_set1_ps(scale);
+	float* tail[2];
+	__m128 a, b;
+	fada_Pos f;
+
+	if (channels == 1)
+	{
+		fada_mix32_i32_sse2(samples, channels, frames, scale, outs[0]);
+		return;
+	}
+
+	if (channels != 2)
+	{
+		fada_deinterleave32_i32(samples, channels, frames, scale, outs);
+		return;
+	}
+
+	for (f = 0; f + 4 <= frames; f += 4)
+	{
+		a = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)&in[2*f]));
+		b = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)&in[2*f+4]));
+		_mm_storeu_ps(&outs[0][f], _mm_mul_ps(_mm_shuffle_ps(a, b, 0x88), s));
+		_mm_storeu_ps(&outs[1][f], _mm_mul_ps(_mm_shuffle_ps(a, b, 0xDD), s));
+	}
+
+	tail[0] = &outs[0][f];
+	tail[1] = &outs[1][f];
+	fada_deinterleave32_i32(&in[2*f], 2, frames - f, scale, tail);
+}
+
+
+
+//////////////////////////////////////////////////
+_FADA_TARGET("sse2") static void fada_mix_f32_sse2(const void* samples, unsigned int channels, fada_Pos frames, fada_Res scale, fada_Res* out)
+{
+	const float* in = (const float*)samples;
+	const __m128d s = _mm_set1_pd(scale);
+	__m128 x;
+	__m128d a, b;
+	fada_Pos f = 0;
+
+	if (channels == 1)
+	{
+		for (; f + 4 <= frames; f += 4)
+		{
+			x = _mm_loadu_ps(&in[f]);
+			_mm_storeu_pd(&out[f], _mm_mul_pd(_mm_cvtps_pd(x), s));
+			_mm_storeu_pd(&out[f+2], _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(x, x)), s));
+		}
+	}
+	else if (channels == 2)
+	{
+		for (; f + 2 <= frames; f += 2)
+		{
+			x = _mm_loadu_ps(&in[2*f]);
+			a = _mm_cvtps_pd(x);
+			b = _mm_cvtps_pd(_mm_movehl_ps(x, x));
+			_mm_storeu_pd(&out[f], _mm_mul_pd(_mm_add_pd(_mm_unpacklo_pd(a, b), _mm_unpackhi_pd(a, b)), s));
+		}
+	}
+
+	fada_mix_f32(&in[f * channels], channels, frames - f, scale, &out[f]);
+}
+
+
+//////////////////////////////////////////////////
+_FADA_TARGET("sse2") static void fada_mix32_f32_sse2(const void* samples, unsigned int channels, fada_Pos frames, float scale, float* out)
+{
+	const float* in = (const float*)samples;
+	const __m128 s = _mm_set1_ps(scale);
+	__m128 a, b;
+	fada_Pos f = 0;
+
+	if (channels == 1)
+	{
+		for (; f + 4 <= frames; f += 4)
+			_mm_storeu_ps(&out[f], _mm_mul_ps(_mm_loadu_ps(&in[f]), s));
+	}
+	else if (channels == 2)
+	{
+		for (; f + 4 <= frames; f += 4)
+		{
+			a = _mm_loadu_ps(&in[2*f]);
+			b = _mm_loadu_ps(&in[2*f+4]);
+			_mm_storeu_ps(&out[f], _mm_mul_ps(_mm_add_ps(_mm_shuffle_ps(a, b, 0x88), _mm_shuffle_ps(a, b, 0xDD)), s));
+		}
+	}
+
+	fada_mix32_f32(&in[f * channels], channels, frames - f, scale, &out[f]);
+}
+
+
+//////////////////////////////////////////////////
+_FADA_TARGET("sse2") static void fada_extract_f32_sse2(const void* samples, unsigned int channels, unsigned int chan, fada_Pos frames, fada_Res scale, fada_Res* out)
+{
+	const float* in = (const float*)samples;
+	const __m128d s = _mm_set1_pd(scale);
+	__m128 a, b;
+	fada_Pos f = 0;
+
+	if (channels == 1)
+	{
+		fada_mix_f32_sse2(samples, channels, frames, scale, out);
+		return;
+	}
+
+	if (channels == 2)
+	{
+		for (; f + 4 <= frames; f += 4)
+		{
+			a = _mm_loadu_ps(&in[2*f]);
+			b = _mm_loadu_ps(&in[2*f+4]);
+			a = chan ? _mm_shuffle_ps(a, b, 0xDD) : _mm_shuffle_ps(a, b, 0x88);
+			_mm_storeu_pd(&out[f], _mm_mul_pd(_mm_cvtps_pd(a), s));
+			_mm_storeu_pd(&out[f+2], _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(a, a)), s));
+		}
+	}
+
+	fada_extract_f32(&in[f * channels], channels, chan, frames - f, scale, &out[f]);
+}
+
+
+//////////////////////////////////////////////////
+_FADA_TARGET("sse2") static void fada_extract32_f32_sse2(const void* samples, unsigned int channels, unsigned int chan, fada_Pos frames, float scale, float* out)
+{
+	const float* in = (const float*)samples;
+	const __m128 s = _mm_set1_ps(scale);
+	__m128 a, b;
+	fada_Pos f = 0;
+
+	if (channels == 1)
+	{
+		fada_mix32_f32_sse2(samples, channels, frames, scale, out);
+		return;
+	}
+
+	if (channels == 2)
+	{
+		for (; f + 4 <= frames; f += 4)
+		{
+			a = _mm_loadu_ps(&in[2*f]);
+			b = _mm_loadu_ps(&in[2*f+4]);
+			a = chan ? _mm_shuffle_ps(a, b, 0xDD) : _mm_shuffle_ps(a, b, 0x88);
+			_mm_storeu_ps(&out[f], _mm_mul_ps(a, s));
+		}
+	}
+
+	fada_extract32_f32(&in[f * channels], channels, chan, frames - f, scale, &out[f]);
+}
+
+//////////////////////////////////////////////////
+_FADA_TARGET("sse2") static void fada_deinterleave_f32_sse2(const void* samples, unsigned int channels, fada_Pos frames, fada_Res scale, fada_Res* const* outs)
+{
+	const float* in = (const float*)samples;
+	const __m128d s = _mm_set1_pd(scale);
+	fada_Res* tail[2];
+	__m128 a, b, l, r;
+	fada_Pos f;
+
+	if (channels == 1)
+	{
+		fada_mix_f32_sse2(samples, channels, frames, scale, outs[0]);
+		return;
+	}
+
+	if (channels != 2)
+	{
+		fada_deinterleave_f32(samples, channels, frames, scale, outs);
+		return;
+	}
+
+	for (f = 0; f + 4 <= frames; f += 4)
+	{
+		a = _mm_loadu_ps(&in[2*f]);
+		b = _mm_loadu_ps(&in[2*f+4]);
+		l = _mm_shuffle_ps(a, b, 0x88);
+		r = _mm_shuffle_ps(a, b, 0xDD);
+		_mm_storeu_pd(&outs[0][f], _mm_mul_pd(_mm_cvtps_pd(l), s));
+		_mm_storeu_pd(&outs[0][f+2], _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(l, l)), s));
+		_mm_storeu_pd(&outs[1][f], _mm_mul_pd(_mm_cvtps_pd(r), s));
+		_mm_storeu_pd(&outs[1][f+2], _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(r, r)), s));
+	}
+
+	tail[0] = &outs[0][f];
+	tail[1] = &outs[1][f];
+	fada_deinterleave_f32(&in[2*f], 2, frames - f, scale, tail);
+}
+
+
+//////////////////////////////////////////////////
+_FADA_TARGET("sse2") static void fada_deinterleave32_f32_sse2(const void* samples, unsigned int channels, fada_Pos frames, float scale, float* const* outs)
+{
+	const float* in = (const float*)samples;
+	const __m128 s = _mm_set1_ps(scale);
+	float* tail[2];
+	__m128 a, b;
+	fada_Pos f;
+
+	if (channels == 1)
+	{
+		fada_mix32_f32_sse2(samples, channels, frames, scale, outs[0]);
+		return;
+	}
+
+	if (channels != 2)
+	{
+		fada_deinterleave32_f32(samples, channels, frames, scale, outs);
+		return;
+	}
+
+	for (f = 0; f + 4 <= frames; f += 4)
+	{
+		a = _mm_loadu_ps(&in[2*f]);
+		b = _mm_loadu_ps(&in[2*f+4]);
+		_mm_storeu_ps(&outs[0][f], _mm_mul_ps(_mm_shuffle_ps(a, b, 0x88), s));
+		_mm_storeu_ps(&outs[1][f], _mm_mul_ps(_mm_shuffle_ps(a, b, 0xDD), s));
+	}
+
+	tail[0] = &outs[0][f];
+	tail[1] = &outs[1][f];
+	fada_deinterleave32_f32(&in[2*f], 2, frames - f, scale, tail);
+}
+
+
+
+static const fada_Converters fada_converters_i16_sse2 = { fada_mix_i16_sse2, fada_mix32_i16_sse2, fada_extract_i16_sse2, fada_extract32_i16_sse2, fada_deinterleave_i16_sse2, fada_deinterleave32_i16_sse2 };
+static const fada_Converters fada_converters_i32_sse2 = { fada_mix_i32_sse2, fada_mix32_i32_sse2, fada_extract_i32_sse2, fada_extract32_i32_sse2, fada_deinterleave_i32_sse2, fada_deinterleave32_i32_sse2 };
+static const fada_Converters fada_converters_f32_sse2 = { fada_mix_f32_sse2, fada_mix32_f32_sse2, fada_extract_f32_sse2, fada_extract32_f32_sse2, fada_deinterleave_f32_sse2, fada_deinterleave32_f32_sse2 };
+
+#endif
+
+
+//////////////////////////////////////////////////
+const fada_Converters* fada_getconverters(fada_TSample type)
+{
+#ifdef _FADA_SIMD_X86
+	if (fada_cpufeatures() & _FADA_CPU_SSE2)
+	{
+		switch (type)
+		{
+			case FADA_TSAMPLE_INT16:   return &fada_converters_i16_sse2;
+			case FADA_TSAMPLE_INT32:   return &fada_converters_i32_sse2;
+			case FADA_TSAMPLE_FLOAT32: return &fada_converters_f32_sse2;
+			default: break;
+		}
+	}
+#endif
+
+	switch (type)
+	{
+		case FADA_TSAMPLE_INT8:    return &fada_converters_i8;
+		case FADA_TSAMPLE_UINT8:   return &fada_converters_u8;
+		case FADA_TSAMPLE_INT16:   return &fada_converters_i16;
+		case FADA_TSAMPLE_INT24:   return &fada_converters_i24;
+		case FADA_TSAMPLE_INT32:   return &fada_converters_i32;
+		case FADA_TSAMPLE_INT64:   return &fada_converters_i64;
+		case FADA_TSAMPLE_FLOAT32: return &fada_converters_f32;
+		case FADA_TSAMPLE_FLOAT64: return &fada_converters_f64;
+		default: return NULL;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+/***********************************************************************************
+ * libfada - Free Audio Detection and Analyzation Library                          *
+ *                                                                                 *
+ * The zlib/libpng License                                                         *
+ * Copyright (c) 2013 Nathan Cousins                                               *
+ *                                                                                 *
+ * This software is provided 'as-is', without any express or implied warranty.     *
+ * In no event will the authors be held liable for any damages arising from the    *
+ * use of this software.                                                           *
+ *                                                                                 *
+ * Permission is granted to anyone to use this software for any purpose,           *
+ * including commercial applications, and to alter it and redistribute it freely,  *
+ * subject to the following restrictions:                                          *
+ *                                                                                 *
+ * 1. The origin of this software must not be misrepresented; you must not claim   *
+ *    that you wrote the original software. If you use this software in a product, *
+ *    an acknowledgment in the product documentation would be appreciated but is   *
+ *    not required.                                                                *
+ *                                                                                 *
+ * 2. Altered source versions must be plainly marked as such, and must not be      *
+ *    misrepresented as being the original software.                               *
+ *                                                                                 *
+ * 3. This notice may not be removed or altered from any source distribution.      *
+ ***********************************************************************************/
+
+#ifndef _FADA_CONVERT_H
+#define _FADA_CONVERT_H
+
+#include <fada/fada_def.h>
+
+
+// Packed little-endian sample of FADA_TSAMPLE_INT24. Only has byte members, so it is 3 bytes with no padding.
+typedef struct fada_Int24
+{
+	unsigned char b[3];
+} fada_Int24;
+
+// Signed values of the sample types that aren't stored as plain signed numbers.
+#define fada_int24value(s) ((int)(((unsigned int)(s).b[0] | ((unsigned int)(s).b[1] << 8) | ((unsigned int)(s).b[2] << 16)) ^ 0x800000U) - 0x800000)
+#define fada_uint8value(s) ((int)(s) - 128)
+
+
+// Conversion of interleaved samples to floating point, with normalization by multiplying with `scale`.
+// mix sums the channels of each frame before scaling, extract picks out one channel,
+// and deinterleave writes every channel to its own output in one pass, with the same values extract gives.
+// The single-precision versions sum and scale in single precision.
+typedef struct fada_Converters fada_Converters;
+
+struct fada_Converters
+{
+	void (*mix)(const void* samples, unsigned int channels, fada_Pos frames, fada_Res scale, fada_Res* out);
+	void (*mix32)(const void* samples, unsigned int channels, fada_Pos frames, float scale, float* out);
+	void (*extract)(const void* samples, unsigned int channels, unsigned int chan, fada_Pos frames, fada_Res scale, fada_Res* out);
+	void (*extract32)(const void* samples, unsigned int channels, unsigned int chan, fada_Pos frames, float scale, float* out);
+	void (*deinterleave)(const void* samples, unsigned int channels, fada_Pos frames, fada_Res scale, fada_Res* const* outs);
+	void (*deinterleave32)(const void* samples, unsigned int channels, fada_Pos frames, float scale, float* const* outs);
+};
+
+// Most outputs the analysis kernels hand to deinterleave at once. They keep the output pointers on the stack,
+// and extract channels one at a time beyond this.
+#define _FADA_DEINTERLEAVE_MAX 16
+
+// Returns the fastest converters this CPU supports for the sample type, or NULL if the type is not supported.
+const fada_Converters* fada_getconverters(fada_TSample type);
+
+#endif
\ No newline at end of file
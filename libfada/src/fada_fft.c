@@ -0,0 +1,515 @@
+/***********************************************************************************
+ * libfada - Free Audio Detection and Analyzation Library                          *
+ *                                                                                 *
+ * The zlib/libpng License                                                         *
+ * Copyright (c) 2013 Nathan Cousins                                               *
+ *                                                                                 *
+ * This software is provided 'as-is', without any express or implied warranty.     *
+ * In no event will the authors be held liable for any damages arising from the    *
+ * use of this software.                                                           *
+ *                                                                                 *
+ * Permission is granted to anyone to use this software for any purpose,           *
+ * including commercial applications, and to alter it and redistribute it freely,  *
+ * subject to the following restrictions:                                          *
+ *                                                                                 *
+ * 1. The origin of this software must not be misrepresented; you must not claim   *
+ *    that you wrote the original software. If you use this software in a product, *
+ *    an acknowledgment in the product documentation would be appreciated but is   *
+ *    not required.                                                                *
+ *                                                                                 *
+ * 2. Altered source versions must be plainly marked as such, and must not be      *
+ *    misrepresented as being the original software.                               *
+ *                                                                                 *
+ * 3. This notice may not be removed or altered from any source distribution.      *
+ ***********************************************************************************/
+
+#include "fada_fft.h"
+
+
+//////////////////////////////////////////////////
+void fada_butterflies_scalar(fada_Res* fft, const fada_Res* twiddles, unsigned int n)
+{
+	unsigned int half, len, start, k;
+	unsigned int a, b;
+	const fada_Res* w;
+	fada_Res wr, wi, tempi, tempr;
+
+	for (half = 1; half < n; half = len)
+	{
+		len = half << 1;
+		w = &twiddles[2*half];
+
+		for (start = 0; start < n; start += len)
+		{
+			for (k = 0; k < half; ++k)
+			{
+				a = 2*(start + k);
+				b = a + len;
+
+				wr = w[2*k];
+				wi = w[2*k+1];
+
+				tempr = wr*fft[b]-wi*fft[b+1];
+				tempi = wr*fft[b+1]+wi*fft[b];
+
+				fft[b] = fft[a]-tempr;
+				fft[b+1] = fft[a+1]-tempi;
+				fft[a] += tempr;
+				fft[a+1] += tempi;
+			}
+		}
+	}
+}
+
+
+//////////////////////////////////////////////////
+static void fada_butterflystage32_scalar(float* fft, const float* w, unsigned int n, unsigned int half)
+{
+	unsigned int len, start, k;
+	unsigned int a, b;
+	float wr, wi, tempi, tempr;
+
+	len = half << 1;
+
+	for (start = 0; start < n; start += len)
+	{
+		for (k = 0; k < half; ++k)
+		{
+			a = 2*(start + k);
+			b = a + len;
+
+			wr = w[2*k];
+			wi = w[2*k+1];
+
+			tempr = wr*fft[b]-wi*fft[b+1];
+			tempi = wr*fft[b+1]+wi*fft[b];
+
+			fft[b] = fft[a]-tempr;
+			fft[b+1] = fft[a+1]-tempi;
+			fft[a] += tempr;
+			fft[a+1] += tempi;
+		}
+	}
+}
+
+
+//////////////////////////////////////////////////
+void fada_butterflies32_scalar(float* fft, const float* twiddles, unsigned int n)
+{
+	unsigned int half;
+
+	for (half = 1; half < n; half <<= 1)
+		fada_butterflystage32_scalar(fft, &twiddles[2*half], n, half);
+}
+
+
+#ifdef _FADA_SIMD_X86
+
+//////////////////////////////////////////////////
+_FADA_TARGET("sse2") void fada_butterflies_sse2(fada_Res* fft, const fada_Res* twiddles, unsigned int n)
+{
+	unsigned int half, len, start, k;
+	fada_Res* a, *b;
+	const fada_Res* w;
+	__m128d x, y, t, wr, wi;
+	const __m128d sign = _mm_set_pd(0., -0.);
+
+	// One complex value per register.
+	for (half = 1; half < n; half = len)
+	{
+		len = half << 1;
+		w = &twiddles[2*half];
+
+		for (start = 0; start < n; start += len)
+		{
+			a = &fft[2*start];
+			b = a + len;
+
+			for (k = 0; k < 2*half; k += 2)
+			{
+				t  = _mm_loadu_pd(&w[k]);
+				wr = _mm_unpacklo_pd(t, t);
+				wi = _mm_xor_pd(_mm_unpackhi_pd(t, t), sign);
+
+				y = _mm_loadu_pd(&b[k]);
+				t = _mm_add_pd(_mm_mul_pd(wr, y), _mm_mul_pd(wi, _mm_shuffle_pd(y, y, 1)));
+
+				x = _mm_loadu_pd(&a[k]);
+				_mm_storeu_pd(&b[k], _mm_sub_pd(x, t));
+				_mm_storeu_pd(&a[k], _mm_add_pd(x, t));
+			}
+		}
+	}
+}
+
+
+//////////////////////////////////////////////////
+_FADA_TARGET("avx") void fada_butterflies_avx(fada_Res* fft, const fada_Res* twiddles, unsigned int n)
+{
+	unsigned int half, len, start, k;
+	fada_Res* a, *b;
+	const fada_Res* w;
+	__m128d x2, y2;
+	__m256d x, y, t, wr, wi;
+
+	// First stage only has a twiddle factor of 1.
+	for (start = 0; start + 1 < n; start += 2)
+	{
+		a = &fft[2*start];
+
+		x2 = _mm_loadu_pd(&a[0]);
+		y2 = _mm_loadu_pd(&a[2]);
+		_mm_storeu_pd(&a[0], _mm_add_pd(x2, y2));
+		_mm_storeu_pd(&a[2], _mm_sub_pd(x2, y2));
+	}
+
+	// Two complex values per register.
+	for (half = 2; half < n; half = len)
+	{
+		len = half << 1;
+		w = &twiddles[2*half];
+
+		for (start = 0; start < n; start += len)
+		{
+			a = &fft[2*start];
+			b = a + len;
+
+			for (k = 0; k < 2*half; k += 4)
+			{
+				t  = _mm256_loadu_pd(&w[k]);
+				wr = _mm256_movedup_pd(t);
+				wi = _mm256_permute_pd(t, 0xF);
+
+				y = _mm256_loadu_pd(&b[k]);
+				t = _mm256_addsub_pd(_mm256_mul_pd(wr, y), _mm256_mul_pd(wi, _mm256_permute_pd(y, 0x5)));
+
+				x = _mm256_loadu_pd(&a[k]);
+				_mm256_storeu_pd(&b[k], _mm256_sub_pd(x, t));
+				_mm256_storeu_pd(&a[k], _mm256_add_pd(x, t));
+			}
+		}
+	}
+}
+
+
+
+//////////////////////////////////////////////////
+_FADA_TARGET("sse") static void fada_butterflystage32_sse(float* fft, const float* w, unsigned int n, unsigned int half)
+{
+	unsigned int len, start, k;
+	float* a, *b;
+	__m128 x, y, t, wr, wi;
+	const __m128 sign = _mm_set_ps(0.f, -0.f, 0.f, -0.f);
+
+	// Two complex values per register, so half must be at least 2.
+	len = half << 1;
+
+	for (start = 0; start < n; start += len)
+	{
+		a = &fft[2*start];
+		b = a + len;
+
+		for (k = 0; k < 2*half; k += 4)
+		{
+			t  = _mm_loadu_ps(&w[k]);
+			wr = _mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 2, 0, 0));
+			wi = _mm_xor_ps(_mm_shuffle_ps(t, t, _MM_SHUFFLE(3, 3, 1, 1)), sign);
+
+			y = _mm_loadu_ps(&b[k]);
+			t = _mm_add_ps(_mm_mul_ps(wr, y), _mm_mul_ps(wi, _mm_shuffle_ps(y, y, _MM_SHUFFLE(2, 3, 0, 1))));
+
+			x = _mm_loadu_ps(&a[k]);
+			_mm_storeu_ps(&b[k], _mm_sub_ps(x, t));
+			_mm_storeu_ps(&a[k], _mm_add_ps(x, t));
+		}
+	}
+}
+
+
+//////////////////////////////////////////////////
+_FADA_TARGET("avx") static void fada_butterflystage32_avx(float* fft, const float* w, unsigned int n, unsigned int half)
+{
+	unsigned int len, start, k;
+	float* a, *b;
+	__m256 x, y, t, wr, wi;
+
+	// Four complex values per register, so half must be at least 4.
+	len = half << 1;
+
+	for (start = 0; start < n; start += len)
+	{
+		a = &fft[2*start];
+		b = a + len;
+
+		for (k = 0; k < 2*half; k += 8)
+		{
+			t  = _mm256_loadu_ps(&w[k]);
+			wr = _mm256_moveldup_ps(t);
+			wi = _mm256_movehdup_ps(t);
+
+			y = _mm256_loadu_ps(&b[k]);
+			t = _mm256_addsub_ps(_mm256_mul_ps(wr, y), _mm256_mul_ps(wi, _mm256_permute_ps(y, 0xB1)));
+
+			x = _mm256_loadu_ps(&a[k]);
+			_mm256_storeu_ps(&b[k], _mm256_sub_ps(x, t));
+			_mm256_storeu_ps(&a[k], _mm256_add_ps(x, t));
+		}
+	}
+}
+
+
+//////////////////////////////////////////////////
+_FADA_TARGET("sse") void fada_butterflies32_sse(float* fft, const float* twiddles, unsigned int n)
+{
+	unsigned int half;
+
+	if (n > 1)
+		fada_butterflystage32_scalar(fft, &twiddles[2], n, 1);
+
+	for (half = 2; half < n; half <<= 1)
+		fada_butterflystage32_sse(fft, &twiddles[2*half], n, half);
+}
+
+
+//////////////////////////////////////////////////
+_FADA_TARGET("avx") void fada_butterflies32_avx(float* fft, const float* twiddles, unsigned int n)
+{
+	unsigned int half;
+
+	if (n > 1)
+		fada_butterflystage32_scalar(fft, &twiddles[2], n, 1);
+
+	if (n > 2)
+		fada_butterflystage32_sse(fft, &twiddles[4], n, 2);
+
+	for (half = 4; half < n; half <<= 1)
+		fada_butterflystage32_avx(fft, &twiddles[2*half], n, half);
+}
+
+#endif
+
+
+#ifdef _FADA_SIMD_AVX512
+
+//////////////////////////////////////////////////
+_FADA_TARGET("avx512f") void fada_butterflies_avx512(fada_Res* fft, const fada_Res* twiddles, unsigned int n)
+{
+	unsigned int half, len, start, k;
+	fada_Res* a, *b;
+	const fada_Res* w;
+	__m128d x2, y2;
+	__m256d x4, y4, t4, wr4, wi4;
+	__m512d x, y, t, wr, wi;
+
+	// First stage only has a twiddle factor of 1.
+	for (start = 0; start + 1 < n; start += 2)
+	{
+		a = &fft[2*start];
+
+		x2 = _mm_loadu_pd(&a[0]);
+		y2 = _mm_loadu_pd(&a[2]);
+		_mm_storeu_pd(&a[0], _mm_add_pd(x2, y2));
+		_mm_storeu_pd(&a[2], _mm_sub_pd(x2, y2));
+	}
+
+	// Second stage has two complex values per half.
+	for (start = 0; start + 3 < n; start += 4)
+	{
+		a = &fft[2*start];
+		b = a + 4;
+
+		t4  = _mm256_loadu_pd(&twiddles[4]);
+		wr4 = _mm256_movedup_pd(t4);
+		wi4 = _mm256_permute_pd(t4, 0xF);
+
+		y4 = _mm256_loadu_pd(b);
+		t4 = _mm256_addsub_pd(_mm256_mul_pd(wr4, y4), _mm256_mul_pd(wi4, _mm256_permute_pd(y4, 0x5)));
+
+		x4 = _mm256_loadu_pd(a);
+		_mm256_storeu_pd(b, _mm256_sub_pd(x4, t4));
+		_mm256_storeu_pd(a, _mm256_add_pd(x4, t4));
+	}
+
+	// Four complex values per register.
+	for (half = 4; half < n; half = len)
+	{
+		len = half << 1;
+		w = &twiddles[2*half];
+
+		for (start = 0; start < n; start += len)
+		{
+			a = &fft[2*start];
+			b = a + len;
+
+			for (k = 0; k < 2*half; k += 8)
+			{
+				t  = _mm512_loadu_pd(&w[k]);
+				wr = _mm512_movedup_pd(t);
+				wi = _mm512_permute_pd(t, 0xFF);
+
+				y = _mm512_loadu_pd(&b[k]);
+				t = _mm512_fmaddsub_pd(wr, y, _mm512_mul_pd(wi, _mm512_permute_pd(y, 0x55)));
+
+				x = _mm512_loadu_pd(&a[k]);
+				_mm512_storeu_pd(&b[k], _mm512_sub_pd(x, t));
+				_mm512_storeu_pd(&a[k], _mm512_add_pd(x, t));
+			}
+		}
+	}
+}
+
+
+
+//////////////////////////////////////////////////
+_FADA_TARGET("avx512f") void fada_butterflies32_avx512(float* fft, const float* twiddles, unsigned int n)
+{
+	unsigned int half, len, start, k;
+	float* a, *b;
+	const float* w;
+	__m512 x, y, t, wr, wi;
+
+	if (n > 1)
+		fada_butterflystage32_scalar(fft, &twiddles[2], n, 1);
+
+	if (n > 2)
+		fada_butterflystage32_sse(fft, &twiddles[4], n, 2);
+
+	if (n > 4)
+		fada_butterflystage32_avx(fft, &twiddles[8], n, 4);
+
+	// Eight complex values per register.
+	for (half = 8; half < n; half = len)
+	{
+		len = half << 1;
+		w = &twiddles[2*half];
+
+		for (start = 0; start < n; start += len)
+		{
+			a = &fft[2*start];
+			b = a + len;
+
+			for (k = 0; k < 2*half; k += 16)
+			{
+				t  = _mm512_loadu_ps(&w[k]);
+				wr = _mm512_moveldup_ps(t);
+				wi = _mm512_movehdup_ps(t);
+
+				y = _mm512_loadu_ps(&b[k]);
+				t = _mm512_fmaddsub_ps(wr, y, _mm512_mul_ps(wi, _mm512_permute_ps(y, 0xB1)));
+
+				x = _mm512_loadu_ps(&a[k]);
+				_mm512_storeu_ps(&b[k], _mm512_sub_ps(x, t));
+				_mm512_storeu_ps(&a[k], _mm512_add_ps(x, t));
+			}
+		}
+	}
+}
+
+#endif
+
+
+#ifdef _FADA_SIMD_X86
+
+//////////////////////////////////////////////////
+static void fada_cpuid(unsigned int leaf, unsigned int subleaf, unsigned int* regs)
+{
+#ifdef _MSC_VER
+	__cpuidex((int*)regs, (int)leaf, (int)subleaf);
+#else
+	__cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+
+//////////////////////////////////////////////////
+unsigned int fada_cpufeatures()
+{
+	unsigned int regs[4];
+	unsigned int max_leaf, features = 0;
+	unsigned long long xcr0 = 0;
+
+	fada_cpuid(0, 0, regs);
+	max_leaf = regs[0];
+
+	if (max_leaf < 1)
+		return 0;
+
+	fada_cpuid(1, 0, regs);
+
+	if (regs[3] & (1U << 25))
+		features |= _FADA_CPU_SSE;
+
+	if (regs[3] & (1U << 26))
+		features |= _FADA_CPU_SSE2;
+
+	// AVX registers are only usable if the OS saves them on context switches (OSXSAVE + XCR0).
+	if (regs[2] & (1U << 27))
+	{
+#ifdef _MSC_VER
+		xcr0 = _xgetbv(0);
+#else
+		unsigned int lo, hi;
+		__asm__ __volatile__ ("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+		xcr0 = ((unsigned long long)hi << 32) | lo;
+#endif
+	}
+
+	if ((regs[2] & (1U << 28)) && (xcr0 & 0x6) == 0x6)
+		features |= _FADA_CPU_AVX;
+
+	if (max_leaf >= 7 && (features & _FADA_CPU_AVX))
+	{
+		fada_cpuid(7, 0, regs);
+
+		if ((regs[1] & (1U << 16)) && (xcr0 & 0xE6) == 0xE6)
+			features |= _FADA_CPU_AVX512F;
+	}
+
+	return features;
+}
+
+#endif
+
+
+//////////////////////////////////////////////////
+fada_FFTButterflies fada_selectbutterflies()
+{
+#ifdef _FADA_SIMD_X86
+	unsigned int features = fada_cpufeatures();
+
+#ifdef _FADA_SIMD_AVX512
+	if (features & _FADA_CPU_AVX512F)
+		return fada_butterflies_avx512;
+#endif
+
+	if (features & _FADA_CPU_AVX)
+		return fada_butterflies_avx;
+
+	if (features & _FADA_CPU_SSE2)
+		return fada_butterflies_sse2;
+#endif
+
+	return fada_butterflies_scalar;
+}
+
+
+//////////////////////////////////////////////////
+fada_FFTButterflies32 fada_selectbutterflies32()
+{
+#ifdef _FADA_SIMD_X86
+	unsigned int features = fada_cpufeatures();
+
+#ifdef _FADA_SIMD_AVX512
+	if (features & _FADA_CPU_AVX512F)
+		return fada_butterflies32_avx512;
+#endif
+
+	if (features & _FADA_CPU_AVX)
+		return fada_butterflies32_avx;
+
+	if (features & _FADA_CPU_SSE)
+		return fada_butterflies32_sse;
+#endif
+
+	return fada_butterflies32_scalar;
+}
@@ -0,0 +1,82 @@
+/***********************************************************************************
+ * libfada - Free Audio Detection and Analyzation Library                          *
+ *                                                                                 *
+ * The zlib/libpng License                                                         *
+ * Copyright (c) 2013 Nathan Cousins                                               *
+ *                                                                                 *
+ * This software is provided 'as-is', without any express or implied warranty.     *
+ * In no event will the authors be held liable for any damages arising from the    *
+ * use of this software.                                                           *
+ *                                                                                 *
+ * Permission is granted to anyone to use this software for any purpose,           *
+ * including commercial applications, and to alter it and redistribute it freely,  *
+ * subject to the following restrictions:                                          *
+ *                                                                                 *
+ * 1. The origin of this software must not be misrepresented; you must not claim   *
+ *    that you wrote the original software. If you use this software in a product, *
+ *    an acknowledgment in the product documentation would be appreciated but is   *
+ *    not required.                                                                *
+ *                                                                                 *
+ * 2. Altered source versions must be plainly marked as such, and must not be      *
+ *    misrepresented as being the original software.                               *
+ *                                                                                 *
+ * 3. This notice may not be removed or altered from any source distribution.      *
+ ***********************************************************************************/
+
+#ifndef _FADA_FFT_H
+#define _FADA_FFT_H
+
+#include <fada/fada_def.h>
+
+// Vectorized kernels are only built for x86 targets, and can be disabled with FADA_NO_SIMD.
+#if !defined(FADA_NO_SIMD) && (defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__))
+	#define _FADA_SIMD_X86
+	#if !defined(_MSC_VER) || _MSC_VER >= 1910
+		#define _FADA_SIMD_AVX512
+	#endif
+#endif
+
+#ifdef _FADA_SIMD_X86
+	#ifdef _MSC_VER
+		#include <intrin.h>
+		#define _FADA_TARGET(isa)
+	#else
+		#include <cpuid.h>
+		#include <immintrin.h>
+		#define _FADA_TARGET(isa) __attribute__((target(isa)))
+	#endif
+
+	#define _FADA_CPU_SSE     0x1
+	#define _FADA_CPU_SSE2    0x2
+	#define _FADA_CPU_AVX     0x4
+	#define _FADA_CPU_AVX512F 0x8
+#endif
+
+
+typedef void (*fada_FFTButterflies)(fada_Res* fft, const fada_Res* twiddles, unsigned int n);
+typedef void (*fada_FFTButterflies32)(float* fft, const float* twiddles, unsigned int n);
+
+void fada_butterflies_scalar(fada_Res* fft, const fada_Res* twiddles, unsigned int n);
+void fada_butterflies32_scalar(float* fft, const float* twiddles, unsigned int n);
+
+#ifdef _FADA_SIMD_X86
+void fada_butterflies_sse2(fada_Res* fft, const fada_Res* twiddles, unsigned int n);
+void fada_butterflies_avx(fada_Res* fft, const fada_Res* twiddles, unsigned int n);
+void fada_butterflies32_sse(float* fft, const float* twiddles, unsigned int n);
+void fada_butterflies32_avx(float* fft, const float* twiddles, unsigned int n);
+#endif
+
+#ifdef _FADA_SIMD_AVX512
+void fada_butterflies_avx512(fada_Res* fft, const fada_Res* twiddles, unsigned int n);
+void fada_butterflies32_avx512(float* fft, const float* twiddles, unsigned int n);
+#endif
+
+#ifdef _FADA_SIMD_X86
+// Returns a combination of the _FADA_CPU flags supported by this CPU and OS.
+unsigned int fada_cpufeatures();
+#endif
+
+fada_FFTButterflies fada_selectbutterflies();
+fada_FFTButterflies32 fada_selectbutterflies32();
+
+#endif
@@ -23,7 +23,9 @@
  * 3. This notice may not be removed or altered from any source distribution.      *
  ***********************************************************************************/
 
+#include <fada/fada.h>
 #include "fada_fftbuffer.h"
+#include "fada_fftplan.h"
 #include "fada_mem.h"
 
 #include <math.h>
@@ -32,33 +34,41 @@
 
 
 //////////////////////////////////////////////////
-FADA_API fada_FFTBuffer* fada_newfftbuffer(fada_Pos size_po2)
+fada_Pos fada_floorpow2(fada_Pos n)
 {
-	fada_FFTBuffer* buf;
-	fada_Pos nearest = size_po2;
-	size_t len;
-
-	//Get the nearest power of two equal or under the window size (x2).
-	if (!_FADA_ISPOW2(nearest))
+	//Get the nearest power of two equal or under n.
+	if (!_FADA_ISPOW2(n))
 	{
-		nearest |= nearest >> 1;
-		nearest |= nearest >> 2;
-		nearest |= nearest >> 4;
-		nearest |= nearest >> 8;
-		nearest |= nearest >> 16;
-		nearest  = (nearest + 1) >> 1;
+		n |= n >> 1;
+		n |= n >> 2;
+		n |= n >> 4;
+		n |= n >> 8;
+		n |= n >> 16;
+		n |= n >> 32;
+		n  = (n + 1) >> 1;
 	}
 
+	return n;
+}
+
+
+//////////////////////////////////////////////////
+static fada_FFTBuffer* fada_createfftbuffer(fada_Pos size_po2, fada_TSample type)
+{
+	fada_FFTBuffer* buf;
+	fada_Pos nearest = fada_floorpow2(size_po2);
+	size_t len;
+
 	// Create buffer object.
 	buf = (fada_FFTBuffer*)fada_memalloc(sizeof(fada_FFTBuffer));
 	if (!buf)
 		return NULL;
 
 	// FFT buffer size is doubled to store both imaginary + complex data per value.
-	len = sizeof(fada_Res) * nearest * 2;
+	len = (type == FADA_TSAMPLE_FLOAT32 ? sizeof(float) : sizeof(fada_Res)) * nearest * 2;
 
 	// Allocate the buffer itself.
-	buf->buffer = (fada_Res*)fada_memalloc(len);
+	buf->buffer = fada_memalign(len, FADA_ALIGNMENT);
 	if (!buf->buffer)
 	{
 		fada_memfree(buf);
@@ -67,14 +77,36 @@ FADA_API fada_FFTBuffer* fada_newfftbuffer(fada_Pos size_po2)
 
 	// Zero the buffer.
 	buf->size = nearest;
+	buf->type = type;
+
+	// FFT plan is created when first needed, unless one is shared through fada_usefftplan.
+	buf->plan = NULL;
+	buf->plan_internal = FADA_FALSE;
 
 	return buf;
 }
 
 
+//////////////////////////////////////////////////
+FADA_API fada_FFTBuffer* fada_newfftbuffer(fada_Pos size_po2)
+{
+	return fada_createfftbuffer(size_po2, FADA_TSAMPLE_FLOAT64);
+}
+
+
+//////////////////////////////////////////////////
+FADA_API fada_FFTBuffer* fada_newfftbuffer32(fada_Pos size_po2)
+{
+	return fada_createfftbuffer(size_po2, FADA_TSAMPLE_FLOAT32);
+}
+
+
 //////////////////////////////////////////////////
 FADA_API void fada_closefftbuffer(fada_FFTBuffer* b)
 {
+	if (b->plan && b->plan_internal)
+		fada_closefftplan(b->plan);
+
 	if (b->buffer)
 		fada_memfree(b->buffer);
 
@@ -82,13 +114,69 @@ FADA_API void fada_closefftbuffer(fada_FFTBuffer* b)
 }
 
 
+//////////////////////////////////////////////////
+FADA_API fada_Error fada_preloadfftplan(fada_FFTBuffer* b)
+{
+	if (!b) return FADA_ERROR_INVALID_FFT_BUFFER;
+
+	if (!b->plan)
+	{
+		b->plan = fada_newfftplan(b->size);
+
+		if (!b->plan)
+			return FADA_ERROR_NOT_ENOUGH_MEMORY;
+
+		b->plan_internal = FADA_TRUE;
+	}
+
+	return FADA_ERROR_SUCCESS;
+}
+
+
+//////////////////////////////////////////////////
+FADA_API fada_Error fada_usefftplan(fada_FFTBuffer* b, fada_FFTPlan* p)
+{
+	if (!b) return FADA_ERROR_INVALID_FFT_BUFFER;
+	if (p && p->size != b->size) return FADA_ERROR_INVALID_SIZE;
+
+	// Close internal plan.
+	if (b->plan && b->plan_internal)
+		fada_closefftplan(b->plan);
+
+	b->plan = p;
+	b->plan_internal = FADA_FALSE;
+
+	return FADA_ERROR_SUCCESS;
+}
+
+
 //////////////////////////////////////////////////
 FADA_API const fada_Res* fada_getfft_buffer(const fada_FFTBuffer* b)
 {
-	if (!b)
+	if (!b || b->type != FADA_TSAMPLE_FLOAT64)
 		return NULL;
 
-	return b->buffer;
+	return (const fada_Res*)b->buffer;
+}
+
+
+//////////////////////////////////////////////////
+FADA_API const float* fada_getfft32_buffer(const fada_FFTBuffer* b)
+{
+	if (!b || b->type != FADA_TSAMPLE_FLOAT32)
+		return NULL;
+
+	return (const float*)b->buffer;
+}
+
+
+//////////////////////////////////////////////////
+FADA_API fada_TSample fada_getffttype_buffer(const fada_FFTBuffer* b)
+{
+	if (!b)
+		return FADA_TSAMPLE_NOTSET;
+
+	return b->type;
 }
 
 
@@ -109,7 +197,16 @@ FADA_API fada_Error fada_getfftvalue_buffer(const fada_FFTBuffer* b, fada_Pos po
 	if (!b) return FADA_ERROR_INVALID_FFT_BUFFER;
 	if (pos >= b->size) return FADA_ERROR_INDEX_OUT_OF_BOUNDS;
 
-	(*out_result) = (fabs(b->buffer[2*pos]) + fabs(b->buffer[2*pos+1])) / b->size;
+	if (b->type == FADA_TSAMPLE_FLOAT32)
+	{
+		const float* fft = (const float*)b->buffer;
+		(*out_result) = (fabsf(fft[2*pos]) + fabsf(fft[2*pos+1])) / b->size;
+	}
+	else
+	{
+		const fada_Res* fft = (const fada_Res*)b->buffer;
+		(*out_result) = (fabs(fft[2*pos]) + fabs(fft[2*pos+1])) / b->size;
+	}
 
 	return FADA_ERROR_SUCCESS;
 }
@@ -118,14 +215,25 @@ FADA_API fada_Error fada_getfftvalue_buffer(const fada_FFTBuffer* b, fada_Pos po
 //////////////////////////////////////////////////
 FADA_API fada_Error fada_getfftvalues_buffer(const fada_FFTBuffer* b, fada_Res* out_results)
 {
-	unsigned int i;
+	fada_Pos i;
 
 	if (!out_results) return FADA_ERROR_INVALID_PARAMETER;
 	if (!b) return FADA_ERROR_INVALID_FFT_BUFFER;
 
-	for (i = 0; i < b->size; ++i)
+	if (b->type == FADA_TSAMPLE_FLOAT32)
 	{
-		out_results[i] = (fabs(b->buffer[2*i]) + fabs(b->buffer[2*i+1])) / b->size;
+		const float* fft = (const float*)b->buffer;
+		const float scale = 1.f / b->size;
+
+		for (i = 0; i < b->size; ++i)
+			out_results[i] = (fabsf(fft[2*i]) + fabsf(fft[2*i+1])) * scale;
+	}
+	else
+	{
+		const fada_Res* fft = (const fada_Res*)b->buffer;
+
+		for (i = 0; i < b->size; ++i)
+			out_results[i] = (fabs(fft[2*i]) + fabs(fft[2*i+1])) / b->size;
 	}
 
 	return FADA_ERROR_SUCCESS;
@@ -135,7 +243,7 @@ FADA_API fada_Error fada_getfftvalues_buffer(const fada_FFTBuffer* b, fada_Res*
 //////////////////////////////////////////////////
 FADA_API fada_Error fada_getfftvaluesrange_buffer(const fada_FFTBuffer* b, fada_Res* out_results, fada_Pos offset, fada_Pos len)
 {
-	unsigned int i;
+	fada_Pos i;
 
 	if (!out_results) return FADA_ERROR_INVALID_PARAMETER;
 	if (!b) return FADA_ERROR_INVALID_FFT_BUFFER;
@@ -145,9 +253,20 @@ FADA_API fada_Error fada_getfftvaluesrange_buffer(const fada_FFTBuffer* b, fada_
 
 	if (offset + len > b->size) return FADA_ERROR_INDEX_OUT_OF_BOUNDS;
 
-	for (i = 0; i < len; ++i)
+	if (b->type == FADA_TSAMPLE_FLOAT32)
 	{
-		out_results[i] = (fabs(b->buffer[2*(i+offset)]) + fabs(b->buffer[2*(i+offset)+1])) / b->size;
+		const float* fft = &((const float*)b->buffer)[2*offset];
+		const float scale = 1.f / b->size;
+
+		for (i = 0; i < len; ++i)
+			out_results[i] = (fabsf(fft[2*i]) + fabsf(fft[2*i+1])) * scale;
+	}
+	else
+	{
+		const fada_Res* fft = &((const fada_Res*)b->buffer)[2*offset];
+
+		for (i = 0; i < len; ++i)
+			out_results[i] = (fabs(fft[2*i]) + fabs(fft[2*i+1])) / b->size;
 	}
 
 	return FADA_ERROR_SUCCESS;
@@ -31,8 +31,14 @@
 
 struct fada_FFTBuffer
 {
-	fada_Res* buffer;
+	void* buffer;
 	unsigned int size;
+	fada_TSample type;
+
+	fada_FFTPlan* plan;
+	fada_Boolean plan_internal;
 };
 
+fada_Pos fada_floorpow2(fada_Pos n);
+
 #endif
\ No newline at end of file
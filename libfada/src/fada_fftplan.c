@@ -0,0 +1,132 @@
+/***********************************************************************************
+ * libfada - Free Audio Detection and Analyzation Library                          *
+ *                                                                                 *
+ * The zlib/libpng License                                                         *
+ * Copyright (c) 2013 Nathan Cousins                                               *
+ *                                                                                 *
+ * This software is provided 'as-is', without any express or implied warranty.     *
+ * In no event will the authors be held liable for any damages arising from the    *
+ * use of this software.                                                           *
+ *                                                                                 *
+ * Permission is granted to anyone to use this software for any purpose,           *
+ * including commercial applications, and to alter it and redistribute it freely,  *
+ * subject to the following restrictions:                                          *
+ *                                                                                 *
+ * 1. The origin of this software must not be misrepresented; you must not claim   *
+ *    that you wrote the original software. If you use this software in a product, *
+ *    an acknowledgment in the product documentation would be appreciated but is   *
+ *    not required.                                                                *
+ *                                                                                 *
+ * 2. Altered source versions must be plainly marked as such, and must not be      *
+ *    misrepresented as being the original software.                               *
+ *                                                                                 *
+ * 3. This notice may not be removed or altered from any source distribution.      *
+ ***********************************************************************************/
+
+#include <fada/fada.h>
+#include "fada_fftplan.h"
+#include "fada_fftbuffer.h"
+#include "fada_mem.h"
+
+#include <math.h>
+
+#define _FADA_PI 3.1415926535897932384626433832795028842
+
+
+//////////////////////////////////////////////////
+FADA_API fada_FFTPlan* fada_newfftplan(fada_Pos size_po2)
+{
+	fada_FFTPlan* p;
+	fada_Pos n, half, k, i, j, bit;
+
+	n = fada_floorpow2(size_po2);
+	if (!n)
+		return NULL;
+
+	// Create plan object.
+	p = (fada_FFTPlan*)fada_memalloc(sizeof(fada_FFTPlan));
+	if (!p)
+		return NULL;
+
+	p->size = n;
+	p->swap_count = 0;
+
+	// Pick the fastest butterfly kernels this CPU supports.
+	p->butterflies = fada_selectbutterflies();
+	p->butterflies32 = fada_selectbutterflies32();
+
+	// Twiddles for the butterfly stage of half-length h are stored contiguously at complex index h.
+	// The last stage (h = n/2) is only used to split the half-size transform of real input.
+	p->twiddles = (fada_Res*)fada_memalign(sizeof(fada_Res) * n * 2, FADA_ALIGNMENT);
+	p->twiddles32 = (float*)fada_memalign(sizeof(float) * n * 2, FADA_ALIGNMENT);
+
+	// There are never more than n/2 swaps in a bit-reversal permutation.
+	p->swaps = (unsigned int*)fada_memalloc(sizeof(unsigned int) * n);
+
+	if (!p->twiddles || !p->twiddles32 || !p->swaps)
+	{
+		fada_closefftplan(p);
+		return NULL;
+	}
+
+	p->twiddles[0] = 1.;
+	p->twiddles[1] = 0.;
+
+	for (half = 1; half < n; half <<= 1)
+	{
+		for (k = 0; k < half; ++k)
+		{
+			p->twiddles[2*(half+k)]   = cos(_FADA_PI * k / half);
+			p->twiddles[2*(half+k)+1] = sin(_FADA_PI * k / half);
+		}
+	}
+
+	// Single-precision copy for FFT buffers created with fada_newfftbuffer32.
+	for (k = 0; k < 2*n; ++k)
+		p->twiddles32[k] = (float)p->twiddles[k];
+
+	// Real input is transformed as n/2 complex values, so the permutation is built for half the size.
+	// Build the list of index pairs the bit-reversal permutation has to swap.
+	for (i = 0, j = 0; i < (n >> 1); ++i)
+	{
+		if (j > i)
+		{
+			p->swaps[2*p->swap_count]   = i;
+			p->swaps[2*p->swap_count+1] = j;
+			++p->swap_count;
+		}
+
+		// Increment j in bit-reversed order.
+		for (bit = n >> 2; bit && (j & bit); bit >>= 1)
+			j ^= bit;
+		j |= bit;
+	}
+
+	return p;
+}
+
+
+//////////////////////////////////////////////////
+FADA_API void fada_closefftplan(fada_FFTPlan* p)
+{
+	if (p->twiddles)
+		fada_memfree(p->twiddles);
+
+	if (p->twiddles32)
+		fada_memfree(p->twiddles32);
+
+	if (p->swaps)
+		fada_memfree(p->swaps);
+
+	fada_memfree(p);
+}
+
+
+//////////////////////////////////////////////////
+FADA_API fada_Pos fada_getfftsize_plan(const fada_FFTPlan* p)
+{
+	if (!p)
+		return 0;
+
+	return p->size;
+}
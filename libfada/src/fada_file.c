@@ -0,0 +1,200 @@
+/***********************************************************************************
+ * libfada - Free Audio Detection and Analyzation Library                          *
+ *                                                                                 *
+ * The zlib/libpng License                                                         *
+ * Copyright (c) 2013 Nathan Cousins                                               *
+ *                                                                                 *
+ * This software is provided 'as-is', without any express or implied warranty.     *
+ * In no event will the authors be held liable for any damages arising from the    *
+ * use of this software.                                                           *
+ *                                                                                 *
+ * Permission is granted to anyone to use this software for any purpose,           *
+ * including commercial applications, and to alter it and redistribute it freely,  *
+ * subject to the following restrictions:                                          *
+ *                                                                                 *
+ * 1. The origin of this software must not be misrepresented; you must not claim   *
+ *    that you wrote the original software. If you use this software in a product, *
+ *    an acknowledgment in the product documentation would be appreciated but is   *
+ *    not required.                                                                *
+ *                                                                                 *
+ * 2. Altered source versions must be plainly marked as such, and must not be      *
+ *    misrepresented as being the original software.                               *
+ *                                                                                 *
+ * 3. This notice may not be removed or altered from any source distribution.      *
+ ***********************************************************************************/
+
+// Needed for madvise.
+#if !defined(_WIN32) && !defined(_DEFAULT_SOURCE)
+	#define _DEFAULT_SOURCE
+#endif
+
+#include "fada_file.h"
+#include "fada_mem.h"
+
+#if defined(_WIN32)
+	#define WIN32_LEAN_AND_MEAN
+	#include <windows.h>
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+// Pages are released in steps of at least this many bytes, to keep system calls rare.
+#define _FADA_FILE_RELEASE_STEP (4U << 20)
+
+
+struct fada_MappedFile
+{
+#if defined(_WIN32)
+	HANDLE mapping;
+#endif
+	void* data;
+	fada_Pos size;
+	fada_Pos page_size;
+	fada_Pos released;
+};
+
+
+//////////////////////////////////////////////////
+fada_MappedFile* fada_mapfile(const char* path)
+{
+	fada_MappedFile* f = (fada_MappedFile*)fada_memalloc(sizeof(fada_MappedFile));
+#if defined(_WIN32)
+	HANDLE file;
+	LARGE_INTEGER size;
+	SYSTEM_INFO info;
+#else
+	struct stat st;
+	int fd;
+#endif
+
+	if (!f)
+		return NULL;
+
+	f->data = NULL;
+	f->size = 0;
+	f->released = 0;
+
+#if defined(_WIN32)
+	file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		fada_memfree(f);
+		return NULL;
+	}
+
+	f->mapping = NULL;
+	if (GetFileSizeEx(file, &size) && size.QuadPart > 0 && (SIZE_T)size.QuadPart == size.QuadPart)
+		f->mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+	// The mapping keeps the file open.
+	CloseHandle(file);
+
+	if (f->mapping)
+		f->data = MapViewOfFile(f->mapping, FILE_MAP_READ, 0, 0, 0);
+
+	if (!f->data)
+	{
+		if (f->mapping)
+			CloseHandle(f->mapping);
+
+		fada_memfree(f);
+		return NULL;
+	}
+
+	GetSystemInfo(&info);
+	f->size = (fada_Pos)size.QuadPart;
+	f->page_size = info.dwPageSize;
+#else
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+	{
+		fada_memfree(f);
+		return NULL;
+	}
+
+	if (fstat(fd, &st) == 0 && st.st_size > 0 && (size_t)st.st_size == (fada_Pos)st.st_size)
+	{
+		f->data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (f->data == MAP_FAILED)
+			f->data = NULL;
+	}
+
+	// The mapping keeps the file open.
+	close(fd);
+
+	if (!f->data)
+	{
+		fada_memfree(f);
+		return NULL;
+	}
+
+	f->size = (fada_Pos)st.st_size;
+	f->page_size = (fada_Pos)sysconf(_SC_PAGESIZE);
+
+	// Audio is mostly read front to back, so let the system read ahead aggressively.
+	madvise(f->data, (size_t)f->size, MADV_SEQUENTIAL);
+#endif
+
+	return f;
+}
+
+
+//////////////////////////////////////////////////
+void fada_unmapfile(fada_MappedFile* f)
+{
+#if defined(_WIN32)
+	UnmapViewOfFile(f->data);
+	CloseHandle(f->mapping);
+#else
+	munmap(f->data, (size_t)f->size);
+#endif
+
+	fada_memfree(f);
+}
+
+
+//////////////////////////////////////////////////
+const void* fada_getmappeddata(const fada_MappedFile* f)
+{
+	return f->data;
+}
+
+
+//////////////////////////////////////////////////
+fada_Pos fada_getmappedsize(const fada_MappedFile* f)
+{
+	return f->size;
+}
+
+
+//////////////////////////////////////////////////
+void fada_releasemappedpages(fada_MappedFile* f, fada_Pos offset)
+{
+	char* start;
+
+	offset -= offset % f->page_size;
+
+	// After seeking back, pages before the new position may have been read in again.
+	if (offset < f->released)
+	{
+		f->released = offset;
+		return;
+	}
+
+	if (offset - f->released < _FADA_FILE_RELEASE_STEP)
+		return;
+
+	start = (char*)f->data + f->released;
+
+#if defined(_WIN32)
+	// Unlocking pages that aren't locked removes them from the working set.
+	VirtualUnlock(start, (SIZE_T)(offset - f->released));
+#else
+	madvise(start, (size_t)(offset - f->released), MADV_DONTNEED);
+#endif
+
+	f->released = offset;
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+/***********************************************************************************
+ * libfada - Free Audio Detection and Analyzation Library                          *
+ *                                                                                 *
+ * The zlib/libpng License                                                         *
+ * Copyright (c) 2013 Nathan Cousins                                               *
+ *                                                                                 *
+ * This software is provided 'as-is', without any express or implied warranty.     *
+ * In no event will the authors be held liable for any damages arising from the    *
+ * use of this software.                                                           *
+ *                                                                                 *
+ * Permission is granted to anyone to use this software for any purpose,           *
+ * including commercial applications, and to alter it and redistribute it freely,  *
+ * subject to the following restrictions:                                          *
+ *                                                                                 *
+ * 1. The origin of this software must not be misrepresented; you must not claim   *
+ *    that you wrote the original software. If you use this software in a product, *
+ *    an acknowledgment in the product documentation would be appreciated but is   *
+ *    not required.                                                                *
+ *                                                                                 *
+ * 2. Altered source versions must be plainly marked as such, and must not be      *
+ *    misrepresented as being the original software.                               *
+ *                                                                                 *
+ * 3. This notice may not be removed or altered from any source distribution.      *
+ ***********************************************************************************/
+
+#ifndef _FADA_FILE_H
+#define _FADA_FILE_H
+
+#include <fada/fada_def.h>
+
+
+typedef struct fada_MappedFile fada_MappedFile;
+
+// Map a whole file read-only into memory. Returns NULL if the file could not be opened or mapped.
+fada_MappedFile* fada_mapfile(const char* path);
+void fada_unmapfile(fada_MappedFile* f);
+
+const void* fada_getmappeddata(const fada_MappedFile* f);
+fada_Pos fada_getmappedsize(const fada_MappedFile* f);
+
+// Drop the pages before offset from memory. They are read from the file again if accessed.
+void fada_releasemappedpages(fada_MappedFile* f, fada_Pos offset);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,628 @@
+/***********************************************************************************
+ * libfada - Free Audio Detection and Analyzation Library                          *
+ *                                                                                 *
+ * The zlib/libpng License                                                         *
+ * Copyright (c) 2013 Nathan Cousins                                               *
+ *                                                                                 *
+ * This software is provided 'as-is', without any express or implied warranty.     *
+ * In no event will the authors be held liable for any damages arising from the    *
+ * use of this software.                                                           *
+ *                                                                                 *
+ * Permission is granted to anyone to use this software for any purpose,           *
+ * including commercial applications, and to alter it and redistribute it freely,  *
+ * subject to the following restrictions:                                          *
+ *                                                                                 *
+ * 1. The origin of this software must not be misrepresented; you must not claim   *
+ *    that you wrote the original software. If you use this software in a product, *
+ *    an acknowledgment in the product documentation would be appreciated but is   *
+ *    not required.                                                                *
+ *                                                                                 *
+ * 2. Altered source versions must be plainly marked as such, and must not be      *
+ *    misrepresented as being the original software.                               *
+ *                                                                                 *
+ * 3. This notice may not be removed or altered from any source distribution.      *
+ ***********************************************************************************/
+
+// Generic analysis kernels, instantiated by fada_calc.c once per sample type and channel layout.
+// There is no include guard; each inclusion expects the following to be defined:
+//
+//   _FADA_KERNEL_T         The sample type.
+//   _FADA_KERNEL_ID        Suffix for the generated names, e.g. i16 or i16_stereo.
+//   _FADA_KERNEL_ABS       Absolute value function for _FADA_KERNEL_T.
+//   _FADA_KERNEL_CHANNELS  Channel count, or 0 to read it from the manager at run time.
+//   _FADA_KERNEL_NORMAL    (Integer types only) The normalizer, matching fada_getnormalizer.
+//   _FADA_KERNEL_VALUE     (Optional) Turns a stored sample into its signed value, for types that aren't plain numbers.
+//   _FADA_KERNEL_SILENCE   (Optional) Byte that silent samples are filled with, if not 0.
+//
+// _FADA_KERNEL_ID and _FADA_KERNEL_CHANNELS are undefined again at the end of this file.
+
+#define _FADA_KERNEL_PASTE2(a,b) a##_##b
+#define _FADA_KERNEL_PASTE(a,b) _FADA_KERNEL_PASTE2(a,b)
+#define _FADA_KERNEL_NAME(name) _FADA_KERNEL_PASTE(name, _FADA_KERNEL_ID)
+
+// A fixed channel count lets the compiler unroll the per-channel loops.
+#if _FADA_KERNEL_CHANNELS
+	#define _FADA_KERNEL_CH _FADA_KERNEL_CHANNELS
+#else
+	#define _FADA_KERNEL_CH m->channels
+#endif
+
+// Packed and offset samples are read through _FADA_KERNEL_VALUE.
+#ifdef _FADA_KERNEL_VALUE
+	#define _FADA_KERNEL_V(x) _FADA_KERNEL_VALUE(x)
+#else
+	#define _FADA_KERNEL_V(x) (x)
+#endif
+
+#ifdef _FADA_KERNEL_SILENCE
+	#define _FADA_KERNEL_FILL _FADA_KERNEL_SILENCE
+#else
+	#define _FADA_KERNEL_FILL 0
+#endif
+
+// Samples are normalized by multiplying with the reciprocal of the normalizer.
+#ifdef _FADA_KERNEL_NORMAL
+	#define _FADA_KERNEL_SCALE (1. / (fada_Res)_FADA_KERNEL_NORMAL)
+#else
+	#define _FADA_KERNEL_SCALE 1.
+#endif
+
+
+//////////////////////////////////////////////////
+static const void* _FADA_KERNEL_NAME(fada_fillwindowbuffer)(fada_Manager* m)
+{
+	_FADA_KERNEL_T* buf = (_FADA_KERNEL_T*)m->window.buffer;
+	fada_Chunk* chunk = m->current_chunk;
+	fada_Pos i, o, n, len;
+
+	if (m->window.filled)
+		return m->window.samples;
+
+	o = m->current_sample;
+
+	// Beat detection peeks at the frame following the window.
+	len = m->window.size + _FADA_KERNEL_CH;
+
+	// Read straight from the chunk if the window lies inside it.
+	if (chunk && o + len <= chunk->sample_count)
+	{
+		m->window.samples = &((_FADA_KERNEL_T*)chunk->samples)[o];
+		m->window.shift = 0;
+		m->window.padded = FADA_FALSE;
+		m->window.filled = FADA_TRUE;
+
+		return m->window.samples;
+	}
+
+	i = 0;
+	if (m->window.shift)
+	{
+		// Keep the part of the previous window that overlaps this one and only copy the new samples.
+		i = len - m->window.shift;
+		fada_memmove(buf, &buf[m->window.shift], i * sizeof(_FADA_KERNEL_T));
+
+		for (o += i; chunk && o >= chunk->sample_count; chunk = chunk->next)
+			o -= chunk->sample_count;
+
+		m->window.shift = 0;
+	}
+
+	m->window.padded = FADA_FALSE;
+	for (; i < len; i += n)
+	{
+		if (chunk)
+		{
+			n = _FADA_MIN(chunk->sample_count - o, len - i);
+			fada_memcopy(&buf[i], &((_FADA_KERNEL_T*)chunk->samples)[o], n * sizeof(_FADA_KERNEL_T));
+			
+			chunk = chunk->next;
+			o = 0;
+		}
+		else
+		{
+			m->window.padded = FADA_TRUE;
+			fada_memset(&buf[i], _FADA_KERNEL_FILL, (len - i) * sizeof(_FADA_KERNEL_T));
+			break;
+		}
+	}
+	
+	m->window.samples = buf;
+	m->window.filled = FADA_TRUE;
+
+	return m->window.samples;
+}
+
+
+//////////////////////////////////////////////////
+static fada_Res _FADA_KERNEL_NAME(fada_sumbeat)(const fada_Manager* m, const _FADA_KERNEL_T* samples, fada_Pos from, fada_Pos to)
+{
+	fada_Pos i;
+	unsigned int chan;
+	fada_Res beat, avg;
+
+	// Only read for the channel count when it isn't fixed.
+	(void)m;
+
+	beat = 0.;
+	for (i = from; i < to; i += _FADA_KERNEL_CH)
+	{
+		avg = 0.;
+
+		for (chan = 0; chan < _FADA_KERNEL_CH; ++chan)
+			avg += _FADA_KERNEL_ABS(_FADA_KERNEL_V(samples[i + chan]) - _FADA_KERNEL_V(samples[i + chan + _FADA_KERNEL_CH]));
+
+		beat += avg / _FADA_KERNEL_CH;
+	}
+
+	return beat;
+}
+
+
+//////////////////////////////////////////////////
+static fada_Res _FADA_KERNEL_NAME(fada_sumbass)(const fada_Manager* m, const _FADA_KERNEL_T* samples, fada_Pos from, fada_Pos to)
+{
+	fada_Pos i, subi;
+	unsigned int chan;
+	fada_Res bass, chan_avg, sub_avg;
+	const unsigned int SUB_PERIOD = 32*_FADA_KERNEL_CH;
+
+	bass = 0.;
+	for (i = from; i < to; i += SUB_PERIOD)
+	{
+		sub_avg = 0.;
+		for (subi = i; subi < i+SUB_PERIOD && subi < m->window.size; subi += _FADA_KERNEL_CH)
+		{
+			chan_avg = 0.;
+
+			for (chan = 0; chan < _FADA_KERNEL_CH; ++chan)
+				chan_avg += _FADA_KERNEL_V(samples[subi + chan]);
+
+			sub_avg += chan_avg / _FADA_KERNEL_CH;
+		}
+		bass += fabs(sub_avg / (SUB_PERIOD / _FADA_KERNEL_CH));
+	}
+
+	return bass;
+}
+
+
+//////////////////////////////////////////////////
+static void _FADA_KERNEL_NAME(fada_slidewindow)(fada_Manager* m, fada_Pos shift)
+{
+	const _FADA_KERNEL_T* samples = (const _FADA_KERNEL_T*)m->window.samples;
+	const unsigned int SUB_PERIOD = 32*_FADA_KERNEL_CH;
+	fada_Pos full = m->window.size - m->window.size % SUB_PERIOD;
+
+	if (m->sums.beat_valid)
+	{
+		// Catch up on a previous slide first, then retire the frames leaving the window.
+		if (m->sums.beat_shift)
+			m->sums.beat += _FADA_KERNEL_NAME(fada_sumbeat)(m, samples, m->window.size - m->sums.beat_shift, m->window.size);
+
+		m->sums.beat -= _FADA_KERNEL_NAME(fada_sumbeat)(m, samples, 0, shift);
+		m->sums.beat_shift = shift;
+	}
+
+	// Bass periods are aligned to the window, so only whole periods can slide.
+	if (m->sums.bass_valid && shift % SUB_PERIOD == 0)
+	{
+		if (m->sums.bass_shift)
+			m->sums.bass += _FADA_KERNEL_NAME(fada_sumbass)(m, samples, full - m->sums.bass_shift, m->window.size);
+
+		// The trailing partial period, if any, won't line up with the next window.
+		m->sums.bass -= _FADA_KERNEL_NAME(fada_sumbass)(m, samples, 0, shift) + _FADA_KERNEL_NAME(fada_sumbass)(m, samples, full, m->window.size);
+		m->sums.bass_shift = shift;
+	}
+	else
+	{
+		m->sums.bass_valid = FADA_FALSE;
+	}
+}
+
+
+//////////////////////////////////////////////////
+static fada_Res _FADA_KERNEL_NAME(fada_getsample)(fada_Manager* m, fada_Pos pos)
+{
+	const _FADA_KERNEL_T* buf;
+	buf = (const _FADA_KERNEL_T*)_FADA_KERNEL_NAME(fada_fillwindowbuffer)(m);
+
+	return (fada_Res)_FADA_KERNEL_V(buf[pos]);
+}
+
+
+//////////////////////////////////////////////////
+static void _FADA_KERNEL_NAME(fada_getsamples)(fada_Manager* m, unsigned int channel, fada_Res* out_results)
+{
+	const _FADA_KERNEL_T* buf;
+	buf = (const _FADA_KERNEL_T*)_FADA_KERNEL_NAME(fada_fillwindowbuffer)(m);
+
+	m->convert->extract(buf, _FADA_KERNEL_CH, channel, m->window.size / _FADA_KERNEL_CH, 1., out_results);
+}
+
+
+//////////////////////////////////////////////////
+static fada_Res _FADA_KERNEL_NAME(fada_getframe)(fada_Manager* m, fada_Pos pos)
+{
+	unsigned int chan;
+	fada_Res res = 0.;
+
+	const _FADA_KERNEL_T* buf;
+	buf = (const _FADA_KERNEL_T*)_FADA_KERNEL_NAME(fada_fillwindowbuffer)(m);
+
+	for (chan = 0; chan < _FADA_KERNEL_CH; ++chan)
+		res += (fada_Res)_FADA_KERNEL_V(buf[pos + chan]);
+
+	return res / _FADA_KERNEL_CH;
+}
+
+
+//////////////////////////////////////////////////
+static void _FADA_KERNEL_NAME(fada_getframes)(fada_Manager* m, fada_Res* out_results)
+{
+	const _FADA_KERNEL_T* buf;
+	buf = (const _FADA_KERNEL_T*)_FADA_KERNEL_NAME(fada_fillwindowbuffer)(m);
+
+	m->convert->mix(buf, _FADA_KERNEL_CH, m->window.size / _FADA_KERNEL_CH, 1. / _FADA_KERNEL_CH, out_results);
+}
+
+
+//////////////////////////////////////////////////
+static fada_Res _FADA_KERNEL_NAME(fada_calcbeat)(fada_Manager* m)
+{
+	const _FADA_KERNEL_T* samples;
+	samples = (const _FADA_KERNEL_T*)_FADA_KERNEL_NAME(fada_fillwindowbuffer)(m);
+
+	if (!m->sums.beat_valid)
+	{
+		m->sums.beat = _FADA_KERNEL_NAME(fada_sumbeat)(m, samples, 0, m->window.size);
+		m->sums.beat_valid = FADA_TRUE;
+	}
+	else if (m->sums.beat_shift)
+	{
+		// Add the frames that slid into the window.
+		m->sums.beat += _FADA_KERNEL_NAME(fada_sumbeat)(m, samples, m->window.size - m->sums.beat_shift, m->window.size);
+	}
+	m->sums.beat_shift = 0;
+
+	return m->sums.beat / (m->window.size / _FADA_KERNEL_CH);
+}
+
+
+//////////////////////////////////////////////////
+static fada_Res _FADA_KERNEL_NAME(fada_calcbeat_channel)(fada_Manager* m, unsigned int chan)
+{
+	fada_Pos i;
+	fada_Res beat;
+	
+	const _FADA_KERNEL_T* samples;
+	samples = (const _FADA_KERNEL_T*)_FADA_KERNEL_NAME(fada_fillwindowbuffer)(m);
+
+	beat = 0.;
+	for (i = 0; i < m->window.size; i += _FADA_KERNEL_CH)
+	{
+		beat += _FADA_KERNEL_ABS(_FADA_KERNEL_V(samples[i + chan]) - _FADA_KERNEL_V(samples[i + chan + _FADA_KERNEL_CH]));
+	}
+
+	return beat / (m->window.size / _FADA_KERNEL_CH);
+}
+
+
+//////////////////////////////////////////////////
+static fada_Res _FADA_KERNEL_NAME(fada_calcbass)(fada_Manager* m)
+{
+	const unsigned int SUB_PERIOD = 32*_FADA_KERNEL_CH;
+	
+	const _FADA_KERNEL_T* samples;
+	samples = (const _FADA_KERNEL_T*)_FADA_KERNEL_NAME(fada_fillwindowbuffer)(m);
+
+	if (!m->sums.bass_valid)
+	{
+		m->sums.bass = _FADA_KERNEL_NAME(fada_sumbass)(m, samples, 0, m->window.size);
+		m->sums.bass_valid = FADA_TRUE;
+	}
+	else if (m->sums.bass_shift)
+	{
+		// Add the periods that slid into the window.
+		m->sums.bass += _FADA_KERNEL_NAME(fada_sumbass)(m, samples, m->window.size - m->window.size % SUB_PERIOD - m->sums.bass_shift, m->window.size);
+	}
+	m->sums.bass_shift = 0;
+
+	return m->sums.bass / ((m->window.size / _FADA_KERNEL_CH) / SUB_PERIOD);
+}
+
+
+//////////////////////////////////////////////////
+static fada_Res _FADA_KERNEL_NAME(fada_calcbass_channel)(fada_Manager* m, unsigned int chan)
+{
+	fada_Pos i, subi;
+	fada_Res bass, sub_avg;
+	const unsigned int SUB_PERIOD = 32*_FADA_KERNEL_CH;
+	
+	const _FADA_KERNEL_T* samples;
+	samples = (const _FADA_KERNEL_T*)_FADA_KERNEL_NAME(fada_fillwindowbuffer)(m);
+
+	bass = 0.;
+	for (i = 0; i < m->window.size; i += SUB_PERIOD)
+	{
+		sub_avg = 0.;
+
+		for (subi = i; subi < i+SUB_PERIOD && subi < m->window.size; subi += _FADA_KERNEL_CH)
+			sub_avg += _FADA_KERNEL_V(samples[subi + chan]);
+
+		bass += fabs(sub_avg / (SUB_PERIOD / _FADA_KERNEL_CH));
+	}
+
+	return bass / ((m->window.size / _FADA_KERNEL_CH) / SUB_PERIOD);
+}
+
+
+//////////////////////////////////////////////////
+static void _FADA_KERNEL_NAME(fada_calcfft)(fada_Manager* m)
+{
+	fada_Pos frames, rate;
+
+	const _FADA_KERNEL_T* samples;
+	fada_Res* fft = (fada_Res*)m->fft.buffer->buffer;
+
+	samples = (const _FADA_KERNEL_T*)_FADA_KERNEL_NAME(fada_fillwindowbuffer)(m);
+
+	rate = m->fft.buffer->size;
+	frames = _FADA_MIN(m->window.size / _FADA_KERNEL_CH, rate);
+
+	m->convert->mix(samples, _FADA_KERNEL_CH, frames, _FADA_KERNEL_SCALE / _FADA_KERNEL_CH, fft);
+	fada_memzero(&fft[frames], (rate - frames) * sizeof(fada_Res));
+
+	fada_calcfft_master(fft, m->fft.buffer->plan);
+}
+
+
+//////////////////////////////////////////////////
+static void _FADA_KERNEL_NAME(fada_calcfft_channel)(fada_Manager* m, unsigned int chan)
+{
+	fada_Pos frames, rate;
+
+	const _FADA_KERNEL_T* samples;
+	fada_Res* fft = (fada_Res*)m->fft.buffer->buffer;
+
+	samples = (const _FADA_KERNEL_T*)_FADA_KERNEL_NAME(fada_fillwindowbuffer)(m);
+
+	rate = m->fft.buffer->size;
+	frames = _FADA_MIN(m->window.size / _FADA_KERNEL_CH, rate);
+
+	m->convert->extract(samples, _FADA_KERNEL_CH, chan, frames, _FADA_KERNEL_SCALE, fft);
+	fada_memzero(&fft[frames], (rate - frames) * sizeof(fada_Res));
+	
+	fada_calcfft_master(fft, m->fft.buffer->plan);
+}
+
+
+//////////////////////////////////////////////////
+static void _FADA_KERNEL_NAME(fada_calcfft32)(fada_Manager* m)
+{
+	fada_Pos frames, rate;
+
+	const _FADA_KERNEL_T* samples;
+	float* fft = (float*)m->fft.buffer->buffer;
+
+	samples = (const _FADA_KERNEL_T*)_FADA_KERNEL_NAME(fada_fillwindowbuffer)(m);
+
+	rate = m->fft.buffer->size;
+	frames = _FADA_MIN(m->window.size / _FADA_KERNEL_CH, rate);
+
+	m->convert->mix32(samples, _FADA_KERNEL_CH, frames, (float)(_FADA_KERNEL_SCALE / _FADA_KERNEL_CH), fft);
+	fada_memzero(&fft[frames], (rate - frames) * sizeof(float));
+
+	fada_calcfft32_master(fft, m->fft.buffer->plan);
+}
+
+
+//////////////////////////////////////////////////
+static void _FADA_KERNEL_NAME(fada_calcfft32_channel)(fada_Manager* m, unsigned int chan)
+{
+	fada_Pos frames, rate;
+
+	const _FADA_KERNEL_T* samples;
+	float* fft = (float*)m->fft.buffer->buffer;
+
+	samples = (const _FADA_KERNEL_T*)_FADA_KERNEL_NAME(fada_fillwindowbuffer)(m);
+
+	rate = m->fft.buffer->size;
+	frames = _FADA_MIN(m->window.size / _FADA_KERNEL_CH, rate);
+
+	m->convert->extract32(samples, _FADA_KERNEL_CH, chan, frames, (float)_FADA_KERNEL_SCALE, fft);
+	fada_memzero(&fft[frames], (rate - frames) * sizeof(float));
+	
+	fada_calcfft32_master(fft, m->fft.buffer->plan);
+}
+
+
+//////////////////////////////////////////////////
+static void _FADA_KERNEL_NAME(fada_calcfft_allchannels)(fada_Manager* m, fada_FFTBuffer** buffers)
+{
+	fada_Pos frames, size;
+	unsigned int chan;
+	fada_Res* outs[_FADA_DEINTERLEAVE_MAX];
+	float* outs32[_FADA_DEINTERLEAVE_MAX];
+
+	const _FADA_KERNEL_T* samples;
+
+	samples = (const _FADA_KERNEL_T*)_FADA_KERNEL_NAME(fada_fillwindowbuffer)(m);
+
+	// All buffers share one size and type, so the window is deinterleaved into every channel's buffer in a single pass.
+	size = buffers[0]->size;
+	frames = _FADA_MIN(m->window.size / _FADA_KERNEL_CH, size);
+
+	if (buffers[0]->type == FADA_TSAMPLE_FLOAT32)
+	{
+		if (_FADA_KERNEL_CH <= _FADA_DEINTERLEAVE_MAX)
+		{
+			for (chan = 0; chan < _FADA_KERNEL_CH; ++chan)
+				outs32[chan] = (float*)buffers[chan]->buffer;
+
+			m->convert->deinterleave32(samples, _FADA_KERNEL_CH, frames, (float)_FADA_KERNEL_SCALE, outs32);
+		}
+		else
+		{
+			for (chan = 0; chan < _FADA_KERNEL_CH; ++chan)
+				m->convert->extract32(samples, _FADA_KERNEL_CH, chan, frames, (float)_FADA_KERNEL_SCALE, (float*)buffers[chan]->buffer);
+		}
+
+		for (chan = 0; chan < _FADA_KERNEL_CH; ++chan)
+		{
+			fada_memzero(&((float*)buffers[chan]->buffer)[frames], (size - frames) * sizeof(float));
+			fada_calcfft32_master((float*)buffers[chan]->buffer, buffers[chan]->plan);
+		}
+	}
+	else
+	{
+		if (_FADA_KERNEL_CH <= _FADA_DEINTERLEAVE_MAX)
+		{
+			for (chan = 0; chan < _FADA_KERNEL_CH; ++chan)
+				outs[chan] = (fada_Res*)buffers[chan]->buffer;
+
+			m->convert->deinterleave(samples, _FADA_KERNEL_CH, frames, _FADA_KERNEL_SCALE, outs);
+		}
+		else
+		{
+			for (chan = 0; chan < _FADA_KERNEL_CH; ++chan)
+				m->convert->extract(samples, _FADA_KERNEL_CH, chan, frames, _FADA_KERNEL_SCALE, (fada_Res*)buffers[chan]->buffer);
+		}
+
+		for (chan = 0; chan < _FADA_KERNEL_CH; ++chan)
+		{
+			fada_memzero(&((fada_Res*)buffers[chan]->buffer)[frames], (size - frames) * sizeof(fada_Res));
+			fada_calcfft_master((fada_Res*)buffers[chan]->buffer, buffers[chan]->plan);
+		}
+	}
+}
+
+
+//////////////////////////////////////////////////
+static void _FADA_KERNEL_NAME(fada_calcfeatures)(fada_Manager* m, fada_Feature features, fada_Res* out_beat, fada_Res* out_bass, fada_Res* out_frames)
+{
+	fada_Pos i, f, frames, fft_size = 0;
+	unsigned int chan;
+	fada_Res beat, bass, sub_avg, chan_avg, avg;
+	float chan_avg32;
+	const unsigned int SUB_PERIOD = 32*_FADA_KERNEL_CH;
+	
+	const _FADA_KERNEL_T* samples;
+	fada_Res* fft = NULL;
+	float* fft32 = NULL;
+
+	samples = (const _FADA_KERNEL_T*)_FADA_KERNEL_NAME(fada_fillwindowbuffer)(m);
+
+	if (features & FADA_FEATURE_FFT)
+	{
+		fft_size = m->fft.buffer->size;
+
+		if (m->fft.buffer->type == FADA_TSAMPLE_FLOAT32)
+			fft32 = (float*)m->fft.buffer->buffer;
+		else
+			fft = (fada_Res*)m->fft.buffer->buffer;
+	}
+
+	frames = m->window.size / _FADA_KERNEL_CH;
+
+	// Walk the window once, feeding every requested feature from the same samples.
+	beat = 0.;
+	bass = 0.;
+	sub_avg = 0.;
+	for (i = 0, f = 0; f < frames; ++f, i += _FADA_KERNEL_CH)
+	{
+		avg = 0.;
+		chan_avg = 0.;
+		chan_avg32 = 0.f;
+
+		for (chan = 0; chan < _FADA_KERNEL_CH; ++chan)
+		{
+			avg += _FADA_KERNEL_ABS(_FADA_KERNEL_V(samples[i + chan]) - _FADA_KERNEL_V(samples[i + chan + _FADA_KERNEL_CH]));
+			chan_avg += (fada_Res)_FADA_KERNEL_V(samples[i + chan]);
+
+			// Single-precision FFT input is summed the same way fada_Converters.mix32 does it.
+			if (fft32)
+				chan_avg32 += (float)_FADA_KERNEL_V(samples[i + chan]);
+		}
+
+		beat += avg / _FADA_KERNEL_CH;
+		sub_avg += chan_avg / _FADA_KERNEL_CH;
+
+		// Close the bass period at its last frame, or at the end of the window.
+		if ((i + _FADA_KERNEL_CH) % SUB_PERIOD == 0 || f + 1 == frames)
+		{
+			bass += fabs(sub_avg / (SUB_PERIOD / _FADA_KERNEL_CH));
+			sub_avg = 0.;
+		}
+
+		if (out_frames)
+			out_frames[f] = chan_avg * (1. / _FADA_KERNEL_CH);
+
+		if (fft && f < fft_size)
+			fft[f] = chan_avg * (_FADA_KERNEL_SCALE / _FADA_KERNEL_CH);
+		else if (fft32 && f < fft_size)
+			fft32[f] = chan_avg32 * (float)(_FADA_KERNEL_SCALE / _FADA_KERNEL_CH);
+	}
+
+	// The full pass leaves the running sums fresh for the next slide.
+	m->sums.beat = beat;
+	m->sums.beat_shift = 0;
+	m->sums.beat_valid = FADA_TRUE;
+
+	m->sums.bass = bass;
+	m->sums.bass_shift = 0;
+	m->sums.bass_valid = FADA_TRUE;
+
+	if (out_beat)
+		(*out_beat) = beat / frames;
+
+	if (out_bass)
+		(*out_bass) = bass / (frames / SUB_PERIOD);
+
+	if (fft)
+	{
+		for (f = frames; f < fft_size; ++f)
+			fft[f] = 0.;
+
+		fada_calcfft_master(fft, m->fft.buffer->plan);
+	}
+	else if (fft32)
+	{
+		for (f = frames; f < fft_size; ++f)
+			fft32[f] = 0.f;
+
+		fada_calcfft32_master(fft32, m->fft.buffer->plan);
+	}
+}
+
+
+//////////////////////////////////////////////////
+static const fada_Kernels _FADA_KERNEL_NAME(fada_kernels) =
+{
+	_FADA_KERNEL_NAME(fada_slidewindow),
+	_FADA_KERNEL_NAME(fada_getsample),
+	_FADA_KERNEL_NAME(fada_getsamples),
+	_FADA_KERNEL_NAME(fada_getframe),
+	_FADA_KERNEL_NAME(fada_getframes),
+	_FADA_KERNEL_NAME(fada_calcbeat),
+	_FADA_KERNEL_NAME(fada_calcbeat_channel),
+	_FADA_KERNEL_NAME(fada_calcbass),
+	_FADA_KERNEL_NAME(fada_calcbass_channel),
+	_FADA_KERNEL_NAME(fada_calcfft),
+	_FADA_KERNEL_NAME(fada_calcfft_channel),
+	_FADA_KERNEL_NAME(fada_calcfft32),
+	_FADA_KERNEL_NAME(fada_calcfft32_channel),
+	_FADA_KERNEL_NAME(fada_calcfft_allchannels),
+	_FADA_KERNEL_NAME(fada_calcfeatures)
+};
+
+
+#undef _FADA_KERNEL_SCALE
+#undef _FADA_KERNEL_FILL
+#undef _FADA_KERNEL_V
+#undef _FADA_KERNEL_CH
+#undef _FADA_KERNEL_NAME
+#undef _FADA_KERNEL_PASTE
+#undef _FADA_KERNEL_PASTE2
+
+#undef _FADA_KERNEL_CHANNELS
+#undef _FADA_KERNEL_ID
\ No newline at end of file
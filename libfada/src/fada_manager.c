@@ -25,16 +25,356 @@
 
 #include <fada/fada.h>
 #include "fada_manager.h"
+#include "fada_calc.h"
 #include "fada_fftbuffer.h"
 #include "fada_mem.h"
+#include "fada_reader.h"
+#include "fada_wav.h"
 
 #include <limits.h>
+#include <stddef.h>
+
+#define _FADA_MIN(a,b) ((a)>(b)?(b):(a))
+
+
+//////////////////////////////////////////////////
+static unsigned int fada_getsamplesize(fada_TSample sample_type)
+{
+	switch (sample_type)
+	{
+		case FADA_TSAMPLE_INT8:    return 1;
+		case FADA_TSAMPLE_UINT8:   return 1;
+		case FADA_TSAMPLE_INT16:   return 2;
+		case FADA_TSAMPLE_INT24:   return 3;
+		case FADA_TSAMPLE_INT32:   return 4;
+		case FADA_TSAMPLE_INT64:   return 8;
+		case FADA_TSAMPLE_FLOAT32: return 4;
+		case FADA_TSAMPLE_FLOAT64: return 8;
+		default: return 0;
+	}
+}
+
+
+//////////////////////////////////////////////////
+static fada_Res fada_getnormal(fada_TSample sample_type)
+{
+	switch (sample_type)
+	{
+		//TODO: Should these be signed maxes?
+		case FADA_TSAMPLE_INT8:    return (fada_Res)UCHAR_MAX / 2.;
+		case FADA_TSAMPLE_UINT8:   return (fada_Res)UCHAR_MAX / 2.;
+		case FADA_TSAMPLE_INT16:   return (fada_Res)USHRT_MAX / 2.;
+		case FADA_TSAMPLE_INT24:   return (fada_Res)0xFFFFFF / 2.;
+		case FADA_TSAMPLE_INT32:   return (fada_Res)UINT_MAX / 2.;
+		case FADA_TSAMPLE_INT64:   return (fada_Res)ULLONG_MAX / 2.;
+		case FADA_TSAMPLE_FLOAT32: return 1.;
+		case FADA_TSAMPLE_FLOAT64: return 1.;
+		default: return 1.;
+	}
+}
+
+
+//////////////////////////////////////////////////
+static void fada_assigntype(fada_Manager* m, fada_TSample sample_type, unsigned int channels)
+{
+	m->sample_type = sample_type;
+	m->store_type = sample_type;
+	m->cache.convert = NULL;
+
+	// Integer samples are converted to normalized floating point as they are pushed, if the cache is enabled.
+	if (m->cache.type != FADA_TSAMPLE_NOTSET && fada_getsamplesize(sample_type) && sample_type != FADA_TSAMPLE_FLOAT32 && sample_type != FADA_TSAMPLE_FLOAT64)
+	{
+		m->store_type = m->cache.type;
+		m->cache.convert = fada_getconverters(sample_type);
+		m->cache.scale = 1. / fada_getnormal(sample_type);
+	}
+
+	m->kernels = fada_getkernels(m->store_type, channels);
+	m->convert = fada_getconverters(m->store_type);
+	m->channels = channels;
+}
+
+
+//////////////////////////////////////////////////
+static void fada_storesamples(const fada_Manager* m, void* dst, void* src, fada_Pos sample_count)
+{
+	if (!m->cache.convert)
+		fada_memcopy(dst, src, sample_count * fada_getsamplesize(m->store_type));
+	else if (m->store_type == FADA_TSAMPLE_FLOAT32)
+		m->cache.convert->extract32(src, 1, 0, sample_count, (float)m->cache.scale, (float*)dst);
+	else
+		m->cache.convert->extract(src, 1, 0, sample_count, m->cache.scale, (fada_Res*)dst);
+}
+
+
+//////////////////////////////////////////////////
+static void fada_freering(fada_Manager* m)
+{
+	if (m->ring.chunk)
+		fada_closechunk(m->ring.chunk);
+
+	if (m->ring.buffer)
+		fada_memfree(m->ring.buffer);
+
+	m->ring.buffer = NULL;
+	m->ring.chunk = NULL;
+	m->ring.capacity = 0;
+	m->ring.read = 0;
+	m->ring.write = 0;
+}
+
+
+//////////////////////////////////////////////////
+static fada_Error fada_pushring(fada_Manager* m, void* data, fada_Pos sample_count)
+{
+	char* ring = (char*)m->ring.buffer;
+	char* src = (char*)data;
+	unsigned int so = m->ring.sample_size;
+	unsigned int si = fada_getsamplesize(m->sample_type);
+	fada_Pos w, o, n;
+
+	// Only the pushing thread modifies the write position.
+	w = m->ring.write;
+
+	if (sample_count > m->ring.capacity - (w - fada_atomicload(&m->ring.read)))
+		return FADA_ERROR_BUFFER_FULL;
+
+	o = w & (m->ring.capacity - 1);
+
+	// Every sample is written to both halves of the ring, so that any range of held samples is contiguous.
+	n = _FADA_MIN(sample_count, m->ring.capacity - o);
+	fada_storesamples(m, &ring[o * so], src, n);
+	fada_memcopy(&ring[(o + m->ring.capacity) * so], &ring[o * so], n * so);
+
+	if (n < sample_count)
+	{
+		// Wrap around to the beginning of the ring.
+		fada_storesamples(m, ring, &src[n * si], sample_count - n);
+		fada_memcopy(&ring[m->ring.capacity * so], ring, (sample_count - n) * so);
+	}
+
+	// Publish the samples to the analysis side.
+	fada_atomicstore(&m->ring.write, w + sample_count);
+
+	return FADA_ERROR_SUCCESS;
+}
+
+
+//////////////////////////////////////////////////
+static fada_Pos fada_getheldsamples(const fada_Manager* m)
+{
+	if (m->ring.chunk)
+		return fada_atomicload(&m->ring.write) - m->ring.read;
+	return m->sample_count;
+}
+
+
+//////////////////////////////////////////////////
+void fada_syncring(fada_Manager* m)
+{
+	fada_Pos n;
+
+	if (!m->ring.chunk)
+		return;
+
+	// Only the analysing thread modifies the read position.
+	n = fada_atomicload(&m->ring.write) - m->ring.read;
+	if (n == m->ring.chunk->sample_count)
+		return;
+
+	// Link the ring chunk once it has samples.
+	if (!m->first_chunk)
+	{
+		m->current_chunk = m->ring.chunk;
+		m->first_chunk = m->ring.chunk;
+		m->last_chunk = m->ring.chunk;
+	}
+
+	m->ring.chunk->sample_count = n;
+	m->sample_count = n;
+}
+
+
+//////////////////////////////////////////////////
+static void fada_resetwindow(fada_Manager* m)
+{
+	m->window.filled = FADA_FALSE;
+	m->window.shift = 0;
+
+	m->sums.beat_valid = FADA_FALSE;
+	m->sums.bass_valid = FADA_FALSE;
+}
+
+
+//////////////////////////////////////////////////
+static fada_Error fada_indexchunk(fada_Manager* m, fada_Chunk* chunk)
+{
+	fada_Chunk** chunks;
+	fada_Pos capacity;
+
+	if (m->index.first + m->index.count == m->index.capacity)
+	{
+		if (m->index.first > m->index.count)
+		{
+			// Reclaim the space left behind by trimmed chunks.
+			fada_memcopy(m->index.chunks, &m->index.chunks[m->index.first], m->index.count * sizeof(fada_Chunk*));
+		}
+		else
+		{
+			capacity = m->index.capacity ? m->index.capacity * 2 : 16;
+
+			chunks = (fada_Chunk**)fada_memalloc(capacity * sizeof(fada_Chunk*));
+			if (!chunks)
+				return FADA_ERROR_NOT_ENOUGH_MEMORY;
+
+			if (m->index.chunks)
+			{
+				fada_memcopy(chunks, &m->index.chunks[m->index.first], m->index.count * sizeof(fada_Chunk*));
+				fada_memfree(m->index.chunks);
+			}
+
+			m->index.chunks = chunks;
+			m->index.capacity = capacity;
+		}
+
+		m->index.first = 0;
+	}
+
+	m->index.chunks[m->index.first + m->index.count] = chunk;
+	m->index.count++;
+
+	return FADA_ERROR_SUCCESS;
+}
+
+
+//////////////////////////////////////////////////
+static void fada_releasesamples(fada_Manager* m, fada_Pos keep)
+{
+	fada_Chunk* cur, *next, *last;
+	fada_Pos freed = 0, pos;
+
+	if (!m->current_chunk)
+		return;
+
+	if (m->ring.chunk)
+	{
+		if (m->current_sample <= keep)
+			return;
+
+		// Release the samples by advancing the start of the ring.
+		freed = m->current_sample - keep;
+
+		m->ring.chunk->samples = &((char*)m->ring.buffer)[((m->ring.read + freed) & (m->ring.capacity - 1)) * m->ring.sample_size];
+		m->ring.chunk->sample_count -= freed;
+
+		m->current_sample -= freed;
+		m->sample_count -= freed;
+
+		// Hand the released samples back to the pushing thread.
+		fada_atomicstore(&m->ring.read, m->ring.read + freed);
+		return;
+	}
+
+	pos = m->current_chunk->position + m->current_sample;
+	if (pos <= keep)
+		return;
+	pos -= keep;
+
+	// Find the newest chunk ending before the kept samples. It and every chunk before it can go.
+	for (last = m->current_chunk->prev; last != NULL && last->position + last->sample_count > pos; last = last->prev);
+
+	if (!last)
+		return;
+
+	m->first_chunk = last->next;
+	m->first_chunk->prev = NULL;
+
+	for (cur = last; cur != NULL; cur = next)
+	{
+		next = cur->prev;
+		freed += cur->sample_count;
+
+		fada_poolclosechunk(&m->pool, cur);
+
+		m->index.first++;
+		m->index.count--;
+	}
+
+	// Update chunk positions.
+	for (cur = m->first_chunk; cur != NULL; cur = next)
+	{
+		next = cur->next;
+		cur->position -= freed;
+	}
+	
+	m->sample_count -= freed;
+}
+
+
+//////////////////////////////////////////////////
+static void fada_applyretention(fada_Manager* m)
+{
+	if (m->retention == FADA_RETAIN_ALL)
+		return;
+
+	if (m->retention > FADA_RETAIN_ALL / m->channels)
+		return;
+
+	fada_releasesamples(m, m->retention * m->channels);
+}
+
+
+//////////////////////////////////////////////////
+static void fada_releasefilepages(fada_Manager* m)
+{
+	const char* start;
+
+	if (!m->file || !m->current_chunk)
+		return;
+
+	// Let pages behind the window go, so a mapped file only occupies memory around the window.
+	start = &((const char*)m->current_chunk->samples)[m->current_sample * fada_getsamplesize(m->store_type)];
+	fada_releasemappedpages(m->file, start - (const char*)fada_getmappeddata(m->file));
+}
 
 
 //////////////////////////////////////////////////
-FADA_API fada_Manager* fada_newmanager()
+static fada_Chunk* fada_findchunk(const fada_Manager* m, fada_Pos pos)
+{
+	fada_Chunk* const* chunks;
+	fada_Pos lo, hi, mid;
+
+	// Bound samples and ring streams are a single chunk, which is not indexed.
+	if (m->first_chunk == m->last_chunk)
+		return m->first_chunk;
+
+	// Binary search for the last chunk starting at or before pos.
+	chunks = &m->index.chunks[m->index.first];
+	lo = 0;
+	hi = m->index.count - 1;
+	while (lo < hi)
+	{
+		mid = lo + (hi - lo + 1) / 2;
+
+		if (chunks[mid]->position <= pos)
+			lo = mid;
+		else
+			hi = mid - 1;
+	}
+
+	return chunks[lo];
+}
+
+
+//////////////////////////////////////////////////
+FADA_API fada_Manager* fada_newmanager_abi(unsigned int abi_version)
 {
 	fada_Manager* m;
+
+	// The caller would disagree with us about the size of fada_Pos and friends.
+	if (abi_version != FADA_ABI_VERSION)
+		return NULL;
+
 	m = (fada_Manager*)fada_memalloc(sizeof(fada_Manager));
 
 	if (!m)
@@ -46,18 +386,56 @@ FADA_API fada_Manager* fada_newmanager()
 
 	m->sample_count = 0;
 	m->current_sample = 0;
+	m->retention = FADA_RETAIN_ALL;
+
+	m->index.chunks = NULL;
+	m->index.first = 0;
+	m->index.count = 0;
+	m->index.capacity = 0;
 
 	m->sample_type = FADA_TSAMPLE_NOTSET;
+	m->store_type = FADA_TSAMPLE_NOTSET;
+	m->kernels = NULL;
+	m->convert = NULL;
 	m->channels = 0;
 	m->sample_rate = 0;
 
 	m->fft.buffer = NULL;
 	m->fft.internal = FADA_FALSE;
+	m->fft.type = FADA_TSAMPLE_FLOAT64;
 
 	m->window.buffer = NULL;
+	m->window.samples = NULL;
 	m->window.size = 0;
+	m->window.capacity = 0;
+	m->window.shift = 0;
+	m->window.sample_size = 0;
 	m->window.filled = FADA_FALSE;
-
+	m->window.padded = FADA_FALSE;
+
+	m->sums.beat = 0.;
+	m->sums.bass = 0.;
+	m->sums.beat_shift = 0;
+	m->sums.bass_shift = 0;
+	m->sums.beat_valid = FADA_FALSE;
+	m->sums.bass_valid = FADA_FALSE;
+	m->sums.slides = 0;
+
+	m->ring.buffer = NULL;
+	m->ring.chunk = NULL;
+	m->ring.capacity = 0;
+	m->ring.read = 0;
+	m->ring.write = 0;
+	m->ring.sample_size = 0;
+
+	m->cache.type = FADA_TSAMPLE_NOTSET;
+	m->cache.convert = NULL;
+	m->cache.scale = 1.;
+
+	fada_initpool(&m->pool, FADA_DEFAULT_POOLSIZE);
+	m->file = NULL;
+
+	m->realtime = FADA_FALSE;
 	m->ready = FADA_FALSE;
 
 	return m;
@@ -68,6 +446,11 @@ FADA_API fada_Manager* fada_newmanager()
 FADA_API void fada_closemanager(fada_Manager* m)
 {
 	fada_freechunks(m);
+	fada_freering(m);
+	fada_clearpool(&m->pool);
+
+	if (m->index.chunks)
+		fada_memfree(m->index.chunks);
 
 	if (m->window.buffer)
 		fada_memfree(m->window.buffer);
@@ -84,6 +467,7 @@ FADA_API fada_Error fada_bindsamples(fada_Manager* m, void* data, fada_Pos sampl
 {
 	fada_Error err;
 
+	if (m->realtime) return FADA_ERROR_WOULD_ALLOCATE;
 	if (!data) return FADA_ERROR_NO_DATA;
 	if (!channels) return FADA_ERROR_INVALID_CHANNEL;
 	if (!sample_count) return FADA_ERROR_INVALID_SIZE;
@@ -91,8 +475,7 @@ FADA_API fada_Error fada_bindsamples(fada_Manager* m, void* data, fada_Pos sampl
 	if (!sample_rate) return FADA_ERROR_INVALID_SAMPLE_RATE;
 
 	// Assign audio information to manager.
-	m->sample_type = sample_type;
-	m->channels = channels;
+	fada_assigntype(m, sample_type, channels);
 	m->sample_rate = sample_rate;
 
 	m->ready = FADA_TRUE;
@@ -107,6 +490,7 @@ FADA_API fada_Error fada_bindsamples(fada_Manager* m, void* data, fada_Pos sampl
 
 	// Make way for our new sample data.
 	fada_freechunks(m);
+	fada_freering(m);
 
 	// Push sample data as one chunk.
 	return fada_pushsamples(m, data, sample_count, copy_data);
@@ -118,12 +502,12 @@ FADA_API fada_Error fada_bindstream(fada_Manager* m, fada_TSample sample_type, u
 {
 	fada_Error err;
 
+	if (m->realtime) return FADA_ERROR_WOULD_ALLOCATE;
 	if (!channels) return FADA_ERROR_INVALID_CHANNEL;
 	if (!sample_rate) return FADA_ERROR_INVALID_SAMPLE_RATE;
 
 	// Assign audio information to manager.
-	m->sample_type = sample_type;
-	m->channels = channels;
+	fada_assigntype(m, sample_type, channels);
 	m->sample_rate = sample_rate;
 
 	m->ready = FADA_TRUE;
@@ -138,11 +522,245 @@ FADA_API fada_Error fada_bindstream(fada_Manager* m, fada_TSample sample_type, u
 	
 	// Make way for new chunks.
 	fada_freechunks(m);
+	fada_freering(m);
 	
 	return FADA_ERROR_SUCCESS;
 }
 
 
+//////////////////////////////////////////////////
+FADA_API fada_Error fada_bindringstream(fada_Manager* m, fada_TSample sample_type, unsigned int sample_rate, unsigned int channels, fada_Pos capacity_frames)
+{
+	fada_Error err;
+	fada_Pos capacity;
+	unsigned int so;
+
+	if (m->realtime) return FADA_ERROR_WOULD_ALLOCATE;
+	if (!capacity_frames) return FADA_ERROR_INVALID_SIZE;
+	if (!channels) return FADA_ERROR_INVALID_CHANNEL;
+
+	so = fada_getsamplesize(sample_type);
+	if (!so) return FADA_ERROR_INVALID_TYPE;
+
+	err = fada_bindstream(m, sample_type, sample_rate, channels);
+	if (err != FADA_ERROR_SUCCESS)
+		return err;
+
+	// The ring holds the samples as stored, which may be cached as floating point.
+	so = fada_getsamplesize(m->store_type);
+
+	// Rounding up to a power of two may double the capacity, and the mirror doubles it again, all of which has to fit a size_t.
+	if (capacity_frames > ((size_t)-1 / 4 / so) / channels)
+	{
+		m->ready = FADA_FALSE;
+		return FADA_ERROR_INVALID_SIZE;
+	}
+
+	// Round the capacity up to a power of two so ring offsets can be masked.
+	for (capacity = 1; capacity < capacity_frames * channels; capacity <<= 1);
+
+	m->ring.chunk = fada_newchunk();
+	m->ring.buffer = fada_memalign(capacity * 2 * so, FADA_ALIGNMENT);
+	if (!m->ring.chunk || !m->ring.buffer)
+	{
+		fada_freering(m);
+		m->ready = FADA_FALSE;
+		return FADA_ERROR_NOT_ENOUGH_MEMORY;
+	}
+
+	m->ring.capacity = capacity;
+	m->ring.read = 0;
+	m->ring.write = 0;
+	m->ring.sample_size = so;
+
+	// The ring chunk references the ring and is never freed with the other chunks.
+	m->ring.chunk->samples = m->ring.buffer;
+	m->ring.chunk->samples_copied = FADA_FALSE;
+
+	return FADA_ERROR_SUCCESS;
+}
+
+
+//////////////////////////////////////////////////
+FADA_API fada_Error fada_bindrealtimestream(fada_Manager* m, fada_TSample sample_type, unsigned int sample_rate, unsigned int channels, fada_Pos capacity_frames, fada_Pos max_window_frames, fada_Pos max_fft_size)
+{
+	fada_Error err;
+
+	if (m->realtime) return FADA_ERROR_WOULD_ALLOCATE;
+	if (!max_window_frames) return FADA_ERROR_INVALID_SIZE;
+
+	err = fada_bindringstream(m, sample_type, sample_rate, channels, capacity_frames);
+	if (err != FADA_ERROR_SUCCESS)
+		return err;
+
+	// Reserve the largest window, then fall back to the default size within it.
+	err = fada_setwindowframes(m, max_window_frames);
+	if (err == FADA_ERROR_SUCCESS)
+	{
+		m->window.capacity = m->window.size;
+
+		// Chunks pooled by earlier bindings could only be released later by fada_setpoolsize, so release them now.
+		fada_clearpool(&m->pool);
+		m->realtime = FADA_TRUE;
+
+		err = fada_setwindowframes(m, _FADA_MIN(max_window_frames, FADA_DEFAULT_WINDOWSIZE));
+	}
+
+	// Create the internal FFT buffer and its plan up front, replacing any buffer in use.
+	if (err == FADA_ERROR_SUCCESS && max_fft_size)
+	{
+		if (m->fft.buffer && m->fft.internal)
+			fada_closefftbuffer(m->fft.buffer);
+
+		if (m->fft.type == FADA_TSAMPLE_FLOAT32)
+			m->fft.buffer = fada_newfftbuffer32(max_fft_size);
+		else
+			m->fft.buffer = fada_newfftbuffer(max_fft_size);
+
+		m->fft.internal = (m->fft.buffer != NULL);
+
+		err = m->fft.buffer ? fada_preloadfftplan(m->fft.buffer) : FADA_ERROR_NOT_ENOUGH_MEMORY;
+	}
+
+	if (err != FADA_ERROR_SUCCESS)
+	{
+		fada_freering(m);
+		m->realtime = FADA_FALSE;
+		m->ready = FADA_FALSE;
+	}
+
+	return err;
+}
+
+
+//////////////////////////////////////////////////
+static fada_Error fada_bindmappedfile(fada_Manager* m, fada_MappedFile* f, fada_Pos offset, fada_Pos size, fada_TSample sample_type, unsigned int sample_rate, unsigned int channels)
+{
+	fada_Error err;
+	unsigned int so;
+
+	so = fada_getsamplesize(sample_type);
+	if (!so || !channels)
+	{
+		fada_unmapfile(f);
+		return !so ? FADA_ERROR_INVALID_TYPE : FADA_ERROR_INVALID_CHANNEL;
+	}
+
+	// Reference the mapped samples directly, ignoring a trailing partial frame.
+	size /= so;
+	size -= size % channels;
+
+	err = fada_bindsamples(m, &((char*)fada_getmappeddata(f))[offset], size, FADA_FALSE, sample_type, sample_rate, channels);
+	if (err != FADA_ERROR_SUCCESS)
+	{
+		fada_unmapfile(f);
+		return err;
+	}
+
+	// Cached samples were converted into the manager, so the file is no longer needed.
+	if (m->cache.convert)
+		fada_unmapfile(f);
+	else
+		m->file = f;
+
+	return FADA_ERROR_SUCCESS;
+}
+
+
+//////////////////////////////////////////////////
+FADA_API fada_Error fada_bindfile(fada_Manager* m, const char* path)
+{
+	fada_MappedFile* f;
+	fada_Error err;
+	fada_TSample sample_type;
+	unsigned int sample_rate, channels;
+	fada_Pos offset, size;
+
+	if (m->realtime) return FADA_ERROR_WOULD_ALLOCATE;
+	if (!path) return FADA_ERROR_INVALID_PARAMETER;
+
+	f = fada_mapfile(path);
+	if (!f)
+		return FADA_ERROR_CANNOT_OPEN_FILE;
+
+	err = fada_parsewav((const unsigned char*)fada_getmappeddata(f), fada_getmappedsize(f), &sample_type, &sample_rate, &channels, &offset, &size);
+	if (err != FADA_ERROR_SUCCESS)
+	{
+		fada_unmapfile(f);
+		return err;
+	}
+
+	return fada_bindmappedfile(m, f, offset, size, sample_type, sample_rate, channels);
+}
+
+
+//////////////////////////////////////////////////
+FADA_API fada_Error fada_bindrawfile(fada_Manager* m, const char* path, fada_Pos offset, fada_TSample sample_type, unsigned int sample_rate, unsigned int channels)
+{
+	fada_MappedFile* f;
+
+	if (m->realtime) return FADA_ERROR_WOULD_ALLOCATE;
+	if (!path) return FADA_ERROR_INVALID_PARAMETER;
+
+	f = fada_mapfile(path);
+	if (!f)
+		return FADA_ERROR_CANNOT_OPEN_FILE;
+
+	if (offset >= fada_getmappedsize(f))
+	{
+		fada_unmapfile(f);
+		return FADA_ERROR_INVALID_SIZE;
+	}
+
+	return fada_bindmappedfile(m, f, offset, fada_getmappedsize(f) - offset, sample_type, sample_rate, channels);
+}
+
+
+//////////////////////////////////////////////////
+static fada_Error fada_bindreaderstream(fada_Manager* m, fada_Reader* r, fada_TSample sample_type, unsigned int sample_rate, unsigned int channels)
+{
+	fada_Error err;
+	unsigned int so = fada_getsamplesize(sample_type);
+
+	if (!so)
+		return FADA_ERROR_INVALID_TYPE;
+
+	err = fada_bindstream(m, sample_type, sample_rate, channels);
+	if (err != FADA_ERROR_SUCCESS)
+		return err;
+
+	return fada_startreader(r, (fada_Pos)so * channels);
+}
+
+
+//////////////////////////////////////////////////
+FADA_API fada_Error fada_bindreader(fada_Manager* m, fada_Reader* r)
+{
+	fada_Error err;
+	fada_TSample sample_type;
+	unsigned int sample_rate, channels;
+
+	if (m->realtime) return FADA_ERROR_WOULD_ALLOCATE;
+	if (!r || r->frame_size) return FADA_ERROR_INVALID_PARAMETER;
+
+	err = fada_readwavheader(r, &sample_type, &sample_rate, &channels);
+	if (err != FADA_ERROR_SUCCESS)
+		return err;
+
+	return fada_bindreaderstream(m, r, sample_type, sample_rate, channels);
+}
+
+
+//////////////////////////////////////////////////
+FADA_API fada_Error fada_bindrawreader(fada_Manager* m, fada_Reader* r, fada_TSample sample_type, unsigned int sample_rate, unsigned int channels)
+{
+	if (m->realtime) return FADA_ERROR_WOULD_ALLOCATE;
+	if (!r || r->frame_size) return FADA_ERROR_INVALID_PARAMETER;
+
+	return fada_bindreaderstream(m, r, sample_type, sample_rate, channels);
+}
+
+
 //////////////////////////////////////////////////
 FADA_API fada_Error fada_pushsamples(fada_Manager* m, void* data, fada_Pos sample_count, fada_Boolean copy_data)
 {
@@ -153,36 +771,33 @@ FADA_API fada_Error fada_pushsamples(fada_Manager* m, void* data, fada_Pos sampl
 	if (!sample_count) return FADA_ERROR_INVALID_SIZE;
 	if (sample_count % m->channels) return FADA_ERROR_NOT_MULTIPLE_OF_CHANNELS;
 
-	newchunk = fada_newchunk();
+	if (m->ring.chunk)
+		return fada_pushring(m, data, sample_count);
+
+	newchunk = fada_poolnewchunk(&m->pool);
 	if (!newchunk)
 		return FADA_ERROR_NOT_ENOUGH_MEMORY;
 
-	// Assign sample data to this new chunk.
-	if (copy_data)
+	// Assign sample data to this new chunk. Cached samples are always converted into a copy.
+	if (copy_data || m->cache.convert)
 	{
-		int so = 1;
-		switch (m->sample_type)
+		unsigned int so = fada_getsamplesize(m->store_type);
+		if (!so)
 		{
-			default: {
-				fada_memfree(newchunk);
-				return FADA_ERROR_INVALID_TYPE;
-			}
-			case FADA_TSAMPLE_INT8:    so = 1; break;
-			case FADA_TSAMPLE_INT16:   so = 2; break;
-			case FADA_TSAMPLE_INT32:   so = 4; break;
-			case FADA_TSAMPLE_INT64:   so = 8; break;
-			case FADA_TSAMPLE_FLOAT32: so = 4; break;
-			case FADA_TSAMPLE_FLOAT64: so = 8; break;
+			fada_poolclosechunk(&m->pool, newchunk);
+			return FADA_ERROR_INVALID_TYPE;
 		}
 
-		newchunk->samples = fada_memalloc(sample_count * so);
+		// The pool may round the block up to its size class.
+		newchunk->samples_size = sample_count * so;
+		newchunk->samples = fada_poolalloc(&m->pool, &newchunk->samples_size);
 		if (!newchunk->samples)
 		{
-			fada_memfree(newchunk);
+			fada_poolclosechunk(&m->pool, newchunk);
 			return FADA_ERROR_NOT_ENOUGH_MEMORY;
 		}
 
-		fada_memcopy(newchunk->samples, data, sample_count * so);
+		fada_storesamples(m, newchunk->samples, data, sample_count);
 
 		newchunk->sample_count = sample_count;
 		newchunk->samples_copied = FADA_TRUE;
@@ -194,6 +809,12 @@ FADA_API fada_Error fada_pushsamples(fada_Manager* m, void* data, fada_Pos sampl
 		newchunk->samples_copied = FADA_FALSE;
 	}
 
+	if (fada_indexchunk(m, newchunk) != FADA_ERROR_SUCCESS)
+	{
+		fada_poolclosechunk(&m->pool, newchunk);
+		return FADA_ERROR_NOT_ENOUGH_MEMORY;
+	}
+
 	// Update chunk links.
 	if (m->first_chunk)
 	{
@@ -213,40 +834,91 @@ FADA_API fada_Error fada_pushsamples(fada_Manager* m, void* data, fada_Pos sampl
 	}
 
 	m->sample_count += newchunk->sample_count;
+
+	fada_applyretention(m);
 	
 	return FADA_ERROR_SUCCESS;
 }
 
 
+
+//////////////////////////////////////////////////
+FADA_API fada_Error fada_readblock(fada_Manager* m, fada_Reader* r)
+{
+	const void* data;
+	fada_Pos size;
+	fada_Error err;
+
+	if (!m->ready) return FADA_ERROR_MANAGER_NOT_READY;
+	if (!r || !r->frame_size) return FADA_ERROR_INVALID_PARAMETER;
+	if (r->frame_size != (fada_Pos)fada_getsamplesize(m->sample_type) * m->channels) return FADA_ERROR_INVALID_TYPE;
+
+	size = fada_acquireblock(r, &data);
+	if (!size)
+		return FADA_ERROR_END_OF_FILE;
+
+	// The block is kept by the reader until it was pushed, so a failed push can be retried.
+	err = fada_pushsamples(m, (void*)data, size / fada_getsamplesize(m->sample_type), FADA_TRUE);
+	if (err != FADA_ERROR_SUCCESS)
+		return err;
+
+	fada_releaseblock(r);
+
+	return FADA_ERROR_SUCCESS;
+}
+
 //////////////////////////////////////////////////
 FADA_API void fada_trimchunks(fada_Manager* m)
 {
-	fada_Chunk* cur, *next;
-	fada_Pos freed = 0;
+	if (!m)
+		return;
+
+	fada_syncring(m);
 
-	if (!m || !m->current_chunk)
+	if (!m->current_chunk)
 		return;
 
-	// Free all previous chunks.
-	for (cur = m->current_chunk->prev; cur != NULL; cur = next)
-	{
-		next = cur->prev;
-		freed += cur->sample_count;
+	// Chunks can only be released whole, so everything before the current one goes. The ring can release up to the current sample.
+	fada_releasesamples(m, m->ring.chunk ? 0 : m->current_sample);
+}
 
-		fada_closechunk(cur);
-	}
-	
-	m->current_chunk->prev = NULL;
 
-	// Update chunk positions.
-	for (cur = m->current_chunk->next; cur != NULL; cur = next)
-	{
-		next = cur->next;
-		cur->position -= freed;
-	}
-	
-	m->sample_count -= freed;
-	m->first_chunk = m->current_chunk;
+//////////////////////////////////////////////////
+FADA_API fada_Error fada_setretention(fada_Manager* m, fada_Pos frames)
+{
+	if (!m)
+		return FADA_ERROR_INVALID_MANAGER;
+
+	m->retention = frames;
+
+	return FADA_ERROR_SUCCESS;
+}
+
+
+//////////////////////////////////////////////////
+FADA_API fada_Error fada_setretentionseconds(fada_Manager* m, fada_Res seconds)
+{
+	if (!m->ready) return FADA_ERROR_MANAGER_NOT_READY;
+	if (seconds < 0.) return FADA_ERROR_INVALID_SIZE;
+
+	if (seconds * m->sample_rate >= (fada_Res)FADA_RETAIN_ALL)
+		return fada_setretention(m, FADA_RETAIN_ALL);
+	return fada_setretention(m, (fada_Pos)(seconds * m->sample_rate));
+}
+
+
+//////////////////////////////////////////////////
+FADA_API fada_Error fada_setsamplecache(fada_Manager* m, fada_TSample cache_type)
+{
+	if (!m)
+		return FADA_ERROR_INVALID_MANAGER;
+
+	if (cache_type != FADA_TSAMPLE_NOTSET && cache_type != FADA_TSAMPLE_FLOAT32 && cache_type != FADA_TSAMPLE_FLOAT64)
+		return FADA_ERROR_INVALID_TYPE;
+
+	m->cache.type = cache_type;
+
+	return FADA_ERROR_SUCCESS;
 }
 
 
@@ -262,18 +934,56 @@ FADA_API void fada_freechunks(fada_Manager* m)
 	{
 		next = cur->next;
 		
-		fada_closechunk(cur);
+		if (cur != m->ring.chunk)
+			fada_poolclosechunk(&m->pool, cur);
+	}
+
+	// Keep the ring itself around, only empty it.
+	if (m->ring.chunk)
+	{
+		fada_Pos w = fada_atomicload(&m->ring.write);
+
+		m->ring.chunk->samples = &((char*)m->ring.buffer)[(w & (m->ring.capacity - 1)) * m->ring.sample_size];
+		m->ring.chunk->sample_count = 0;
+
+		fada_atomicstore(&m->ring.read, w);
 	}
 
 	m->first_chunk = NULL;
 	m->current_chunk = NULL;
 	m->last_chunk = NULL;
 
+	m->index.first = 0;
+	m->index.count = 0;
+
 	m->current_sample = 0;
 	m->sample_count = 0;
+
+	// A mapped file is only referenced by the chunk that was just freed.
+	if (m->file)
+	{
+		fada_unmapfile(m->file);
+		m->file = NULL;
+	}
+
+	// The window may have been pointing into a freed chunk.
+	fada_resetwindow(m);
+}
+
+
+//////////////////////////////////////////////////
+FADA_API fada_Error fada_setpoolsize(fada_Manager* m, fada_Pos bytes)
+{
+	if (!m)
+		return FADA_ERROR_INVALID_MANAGER;
+
+	fada_resizepool(&m->pool, bytes);
+
+	return FADA_ERROR_SUCCESS;
 }
 
 
+
 //////////////////////////////////////////////////
 FADA_API fada_TSample fata_getsampletype(const fada_Manager* m)
 {
@@ -289,20 +999,20 @@ FADA_API unsigned int fada_getsamplerate(const fada_Manager* m)
 
 
 //////////////////////////////////////////////////
-FADA_API unsigned int fada_getsamplecount(const fada_Manager* m)
+FADA_API fada_Pos fada_getsamplecount(const fada_Manager* m)
 {
 	if (!m->ready)
 		return 0;
-	return m->sample_count;
+	return fada_getheldsamples(m);
 }
 
 
 //////////////////////////////////////////////////
-FADA_API unsigned int fada_getframecount(const fada_Manager* m)
+FADA_API fada_Pos fada_getframecount(const fada_Manager* m)
 {
 	if (!m->ready)
 		return 0;
-	return m->sample_count / m->channels;
+	return fada_getheldsamples(m) / m->channels;
 }
 
 
@@ -316,6 +1026,8 @@ FADA_API unsigned int fada_getchannels(const fada_Manager* m)
 //////////////////////////////////////////////////
 FADA_API fada_Pos fada_getposition(const fada_Manager* m)
 {
+	if (!m->current_chunk)
+		return 0;
 	return (m->current_chunk->position + m->current_sample) / m->channels;
 }
 
@@ -342,6 +1054,8 @@ FADA_API fada_Error fada_setposition(fada_Manager* m, fada_Pos pos)
 	if (!m->ready)
 		return FADA_ERROR_MANAGER_NOT_READY;
 
+	fada_syncring(m);
+
 	// Internally we use samples.
 	pos *= m->channels;
 
@@ -349,15 +1063,12 @@ FADA_API fada_Error fada_setposition(fada_Manager* m, fada_Pos pos)
 		return FADA_ERROR_POSITION_OUT_OF_BOUNDS;
 	
 	// Find the appropriate chunk for the requested position.
-	for (chunk = m->first_chunk; chunk != NULL; chunk = chunk->next)
-	{
-		if (chunk->position + chunk->sample_count > pos)
-		{
-			m->current_sample = pos - chunk->position;
-			m->current_chunk = chunk;
-			break;
-		}
-	}
+	chunk = fada_findchunk(m, pos);
+
+	m->current_sample = pos - chunk->position;
+	m->current_chunk = chunk;
+
+	fada_resetwindow(m);
 
 	return FADA_ERROR_SUCCESS;
 }
@@ -366,27 +1077,33 @@ FADA_API fada_Error fada_setposition(fada_Manager* m, fada_Pos pos)
 //////////////////////////////////////////////////
 FADA_API fada_Error fada_setwindowframes(fada_Manager* m, fada_Pos frames)
 {
-	int so;
+	unsigned int so;
 	void* buf;
 
 	if (!frames) return FADA_ERROR_INVALID_SIZE;
 	if (!m->ready) return FADA_ERROR_MANAGER_NOT_READY;
 
-	if (frames == m->window.size / m->channels)
+	so = fada_getsamplesize(m->store_type);
+	if (!so) return FADA_ERROR_INVALID_TYPE;
+
+	// Rebinding may have changed how samples are stored, so the buffer is only kept if its elements still fit.
+	if (frames == m->window.size / m->channels && so == m->window.sample_size)
 		return FADA_ERROR_SUCCESS;
 
-	switch (m->sample_type)
+	// Real-time managers only resize within the window reserved up front.
+	if (m->realtime)
 	{
-		default: return FADA_ERROR_INVALID_TYPE;
-		case FADA_TSAMPLE_INT8:    so = 1; break;
-		case FADA_TSAMPLE_INT16:   so = 2; break;
-		case FADA_TSAMPLE_INT32:   so = 4; break;
-		case FADA_TSAMPLE_INT64:   so = 8; break;
-		case FADA_TSAMPLE_FLOAT32: so = 4; break;
-		case FADA_TSAMPLE_FLOAT64: so = 8; break;
+		if (frames > m->window.capacity / m->channels)
+			return FADA_ERROR_WOULD_ALLOCATE;
+
+		m->window.size = frames * m->channels;
+		fada_resetwindow(m);
+
+		return FADA_ERROR_SUCCESS;
 	}
 
-	buf = fada_memalloc(frames * m->channels * so);
+	// One extra frame is kept for beat detection, which reads past the window.
+	buf = fada_memalign((frames + 1) * m->channels * so, FADA_ALIGNMENT);
 	if (!buf)
 		return FADA_ERROR_NOT_ENOUGH_MEMORY;
 
@@ -395,7 +1112,9 @@ FADA_API fada_Error fada_setwindowframes(fada_Manager* m, fada_Pos frames)
 
 	m->window.buffer = buf;
 	m->window.size   = frames * m->channels;
-	m->window.filled = FADA_FALSE;
+	m->window.sample_size = so;
+
+	fada_resetwindow(m);
 
 	return FADA_ERROR_SUCCESS;
 }
@@ -405,39 +1124,59 @@ FADA_API fada_Error fada_setwindowframes(fada_Manager* m, fada_Pos frames)
 FADA_API fada_Boolean fada_continue(fada_Manager* m, long offset_frames)
 {
 	fada_Chunk* chunk;
+	fada_Pos start, pos;
 	
 	if (!m->ready)
 		return FADA_FALSE;
 
+	fada_syncring(m);
+
 	if (!m->current_chunk)
 		return FADA_FALSE;
 
 	if (fada_endofaudio(m))
 		return FADA_FALSE;
 	
-	m->window.filled = FADA_FALSE;
+	start = m->current_chunk->position + m->current_sample;
 
 	// Move current sample forward.
 	if (offset_frames < 0)
-		m->current_sample += -offset_frames * m->window.size;
+		m->current_sample += (fada_Pos)-offset_frames * m->window.size;
 	else
-		m->current_sample += offset_frames * m->channels;
+		m->current_sample += (fada_Pos)offset_frames * m->channels;
 
-	// Continue to the next chunk if we've surpassed this one.
-	for (chunk = m->current_chunk; m->current_sample >= chunk->sample_count; m->current_sample -= chunk->sample_count)
+	// Continue to the chunk holding the new position if we've surpassed this one.
+	if (m->current_sample >= m->current_chunk->sample_count)
 	{
-		if (chunk->next)
+		pos = m->current_chunk->position + m->current_sample;
+
+		if (pos >= m->sample_count)
 		{
-			chunk = chunk->next;
+			// Reached last chunk.
+			chunk = m->last_chunk;
+			m->current_sample = chunk->sample_count;
 		}
 		else
 		{
-			// Reached last chunk.
-			m->current_sample = chunk->sample_count;
-			break;
+			chunk = fada_findchunk(m, pos);
+			m->current_sample = pos - chunk->position;
 		}
+
+		m->current_chunk = chunk;
 	}
-	m->current_chunk = chunk;
+
+	// If the new window overlaps the old one, only the frames that moved in or out of it need to be analysed.
+	pos = m->current_chunk->position + m->current_sample - start;
+	if (m->window.filled && !m->window.padded && pos > 0 && pos < m->window.size)
+		fada_slidewindow(m, pos);
+	else
+		fada_resetwindow(m);
+
+	m->window.filled = FADA_FALSE;
+
+	// The window has moved past these samples for good.
+	fada_applyretention(m);
+	fada_releasefilepages(m);
 	
 	return !fada_endofaudio(m);
 }
@@ -447,42 +1186,24 @@ FADA_API fada_Boolean fada_continue(fada_Manager* m, long offset_frames)
 FADA_API fada_Boolean fada_continuetolast(fada_Manager* m)
 {
 	fada_Chunk* chunk;
-	int n;
+	fada_Pos pos;
 	
 	if (!m->ready)
 		return FADA_FALSE;
 
+	fada_syncring(m);
+
 	if (!m->current_chunk)
 		return FADA_FALSE;
 
-	m->window.filled = FADA_FALSE;
-
-	n = m->window.size;
-	for (chunk = m->last_chunk; n > 0;)
-	{
-		n -= chunk->sample_count;
+	fada_resetwindow(m);
 
-		if (n <= 0)
-		{
-			break;
-		}
-		else
-		{
-			if (chunk->prev)
-			{
-				chunk = chunk->prev;
-			}
-			else
-			{
-				m->current_chunk = chunk;
-				m->current_sample = 0;
+	// Seek to the last full window, or the beginning if there isn't one.
+	pos = (m->sample_count > m->window.size) ? m->sample_count - m->window.size : 0;
+	chunk = fada_findchunk(m, pos);
 
-				return FADA_TRUE;
-			}
-		}
-	}
 	m->current_chunk = chunk;
-	m->current_sample = chunk->sample_count + n;
+	m->current_sample = pos - chunk->position;
 	
 	return FADA_TRUE;
 }
@@ -491,6 +1212,10 @@ FADA_API fada_Boolean fada_continuetolast(fada_Manager* m)
 //////////////////////////////////////////////////
 FADA_API fada_Boolean fada_endofaudio(const fada_Manager* m)
 {
+	// The ring is a single chunk, but may hold samples not yet synced to it.
+	if (m->ring.chunk)
+		return (m->current_sample >= fada_getheldsamples(m));
+
 	if (!m->current_chunk)
 		return FADA_TRUE;
 	return ((m->current_chunk->position + m->current_sample) >= m->sample_count);
@@ -502,17 +1227,8 @@ FADA_API fada_Res fada_getnormalizer(const fada_Manager* m)
 {
 	if (!m->ready) return 1.;
 
-	switch (m->sample_type)
-	{
-		//TODO: Should these be signed maxes?
-		case FADA_TSAMPLE_INT8:    return (fada_Res)UCHAR_MAX / 2.;
-		case FADA_TSAMPLE_INT16:   return (fada_Res)USHRT_MAX / 2.;
-		case FADA_TSAMPLE_INT32:   return (fada_Res)UINT_MAX / 2.;
-		case FADA_TSAMPLE_INT64:   return (fada_Res)ULLONG_MAX / 2.;
-		case FADA_TSAMPLE_FLOAT32: return 1.;
-		case FADA_TSAMPLE_FLOAT64: return 1.;
-		default: return 1.;
-	}
+	// Cached samples are already normalized.
+	return fada_getnormal(m->store_type);
 }
 
 
@@ -521,9 +1237,15 @@ FADA_API fada_Error fada_preloadfftbuffer(fada_Manager* m)
 {
 	if (!m->ready) return FADA_ERROR_MANAGER_NOT_READY;
 
+	if (m->realtime && (!m->fft.buffer || !m->fft.buffer->plan))
+		return FADA_ERROR_WOULD_ALLOCATE;
+
 	if (!m->fft.buffer)
 	{
-		m->fft.buffer = fada_newfftbuffer(m->window.size / m->channels);
+		if (m->fft.type == FADA_TSAMPLE_FLOAT32)
+			m->fft.buffer = fada_newfftbuffer32(m->window.size / m->channels);
+		else
+			m->fft.buffer = fada_newfftbuffer(m->window.size / m->channels);
 
 		if (!m->fft.buffer)
 			return FADA_ERROR_NOT_ENOUGH_MEMORY;
@@ -531,7 +1253,8 @@ FADA_API fada_Error fada_preloadfftbuffer(fada_Manager* m)
 		m->fft.internal = FADA_TRUE;
 	}
 
-	return FADA_ERROR_SUCCESS;
+	// Make sure the buffer in use has twiddle and permutation tables ready.
+	return fada_preloadfftplan(m->fft.buffer);
 }
 
 
@@ -539,6 +1262,7 @@ FADA_API fada_Error fada_preloadfftbuffer(fada_Manager* m)
 FADA_API fada_Error fada_usefftbuffer(fada_Manager* m, fada_FFTBuffer* b)
 {
 	if (!m->ready) return FADA_ERROR_MANAGER_NOT_READY;
+	if (m->realtime) return FADA_ERROR_WOULD_ALLOCATE;
 
 	// Close internal buffer.
 	if (m->fft.buffer && m->fft.internal)
@@ -551,12 +1275,43 @@ FADA_API fada_Error fada_usefftbuffer(fada_Manager* m, fada_FFTBuffer* b)
 }
 
 
+//////////////////////////////////////////////////
+FADA_API fada_Error fada_setffttype(fada_Manager* m, fada_TSample type)
+{
+	if (type != FADA_TSAMPLE_FLOAT32 && type != FADA_TSAMPLE_FLOAT64)
+		return FADA_ERROR_INVALID_TYPE;
+
+	if (type == m->fft.type)
+		return FADA_ERROR_SUCCESS;
+
+	if (m->realtime)
+		return FADA_ERROR_WOULD_ALLOCATE;
+
+	// Close internal buffer, it will be recreated with the new type when needed.
+	if (m->fft.buffer && m->fft.internal)
+	{
+		fada_closefftbuffer(m->fft.buffer);
+		m->fft.buffer = NULL;
+		m->fft.internal = FADA_FALSE;
+	}
+
+	m->fft.type = type;
+
+	return FADA_ERROR_SUCCESS;
+}
+
+
 //////////////////////////////////////////////////
 FADA_API const fada_Res* fada_getfft(const fada_Manager* m)
 {
-	if (!m->fft.buffer)
-		return NULL;
-	return m->fft.buffer->buffer;
+	return fada_getfft_buffer(m->fft.buffer);
+}
+
+
+//////////////////////////////////////////////////
+FADA_API const float* fada_getfft32(const fada_Manager* m)
+{
+	return fada_getfft32_buffer(m->fft.buffer);
 }
 
 
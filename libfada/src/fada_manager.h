@@ -28,6 +28,11 @@
 
 #include <fada/fada_def.h>
 #include "fada_chunk.h"
+#include "fada_pool.h"
+#include "fada_file.h"
+#include "fada_calc.h"
+#include "fada_convert.h"
+#include "fada_atomic.h"
 
 
 struct fada_Manager
@@ -38,7 +43,11 @@ struct fada_Manager
 	
 	fada_Pos current_sample;
 	fada_Pos sample_count;
+	fada_Pos retention;
 	fada_TSample sample_type;
+	fada_TSample store_type;
+	const fada_Kernels* kernels;
+	const fada_Converters* convert;
 
 	unsigned int channels;
 	unsigned int sample_rate;
@@ -46,17 +55,67 @@ struct fada_Manager
 	struct
 	{
 		void* buffer;
+		const void* samples;
 		fada_Pos size;
+		fada_Pos capacity;
+		fada_Pos shift;
+		unsigned int sample_size;
 		fada_Boolean filled;
+		fada_Boolean padded;
 	} window;
 
+	struct
+	{
+		fada_Res beat;
+		fada_Res bass;
+		fada_Pos beat_shift;
+		fada_Pos bass_shift;
+		fada_Boolean beat_valid;
+		fada_Boolean bass_valid;
+		unsigned int slides;
+	} sums;
+
+	struct
+	{
+		fada_Chunk** chunks;
+		fada_Pos first;
+		fada_Pos count;
+		fada_Pos capacity;
+	} index;
+
+	struct
+	{
+		void* buffer;
+		fada_Chunk* chunk;
+		fada_Pos capacity;
+		fada_AtomicPos read;
+		fada_AtomicPos write;
+		unsigned int sample_size;
+	} ring;
+
 	struct
 	{
 		fada_FFTBuffer* buffer;
 		fada_Boolean internal;
+		fada_TSample type;
 	} fft;
 
+	struct
+	{
+		fada_TSample type;
+		const fada_Converters* convert;
+		fada_Res scale;
+	} cache;
+
+	fada_Pool pool;
+	fada_MappedFile* file;
+
+	fada_Boolean realtime;
 	fada_Boolean ready;
 };
 
+
+// Make samples pushed to the ring visible to the analysis side of the manager.
+void fada_syncring(fada_Manager* m);
+
 #endif
\ No newline at end of file
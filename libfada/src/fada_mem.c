@@ -23,23 +23,99 @@
  * 3. This notice may not be removed or altered from any source distribution.      *
  ***********************************************************************************/
 
+// Needed for posix_memalign.
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+	#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <fada/fada.h>
 #include "fada_mem.h"
 
 #include <stdlib.h>
 #include <memory.h>
 
+#if defined(_WIN32)
+	#include <malloc.h>
+#endif
+
+// Alignment malloc already guarantees.
+#define _FADA_MEM_MINALIGN (2 * sizeof(void*))
+
+
+// Installed allocator, NULL for the system allocator.
+static fada_AllocFunc fada_allocfunc = NULL;
+static fada_FreeFunc fada_freefunc = NULL;
+static void* fada_allocuserdata = NULL;
+
+
+//////////////////////////////////////////////////
+FADA_API fada_Error fada_setallocator(fada_AllocFunc alloc_func, fada_FreeFunc free_func, void* userdata)
+{
+	// Blocks must always be released by the allocator that created them.
+	if (!alloc_func != !free_func)
+		return FADA_ERROR_INVALID_PARAMETER;
+
+	fada_allocfunc = alloc_func;
+	fada_freefunc = free_func;
+	fada_allocuserdata = userdata;
+
+	return FADA_ERROR_SUCCESS;
+}
+
 
 //////////////////////////////////////////////////
 void* fada_memalloc(fada_Pos len)
 {
-	return malloc(len);
+	return fada_memalign(len, _FADA_MEM_MINALIGN);
+}
+
+
+//////////////////////////////////////////////////
+void* fada_memalign(fada_Pos len, fada_Pos alignment)
+{
+	void* ptr;
+
+	if (alignment < _FADA_MEM_MINALIGN)
+		alignment = _FADA_MEM_MINALIGN;
+	else
+		len = (len + alignment - 1) & ~(alignment - 1); // Don't share the last line with another block.
+
+	// Sizes beyond the address space of 32-bit platforms.
+	if ((size_t)len != len)
+		return NULL;
+
+	if (fada_allocfunc)
+		return fada_allocfunc(len, alignment, fada_allocuserdata);
+
+#if defined(_WIN32)
+	// Every default block comes from here, so fada_memfree can always use _aligned_free.
+	ptr = _aligned_malloc(len, alignment);
+#else
+	if (alignment == _FADA_MEM_MINALIGN)
+		return malloc(len);
+
+	if (posix_memalign(&ptr, alignment, len))
+		return NULL;
+#endif
+
+	return ptr;
 }
 
 
 //////////////////////////////////////////////////
 void fada_memfree(void* ptr)
 {
-	free(ptr);
+	if (!ptr)
+		return;
+
+	if (fada_freefunc)
+		fada_freefunc(ptr, fada_allocuserdata);
+	else
+#if defined(_WIN32)
+		_aligned_free(ptr);
+#else
+		free(ptr);
+#endif
 }
 
 
@@ -50,8 +126,22 @@ void* fada_memcopy(void* dest, void* src, fada_Pos len)
 }
 
 
+//////////////////////////////////////////////////
+void* fada_memmove(void* dest, void* src, fada_Pos len)
+{
+	return memmove(dest, src, len);
+}
+
+
 //////////////////////////////////////////////////
 void* fada_memzero(void* dest, fada_Pos len)
 {
 	return memset(dest, 0, len);
+}
+
+
+//////////////////////////////////////////////////
+void* fada_memset(void* dest, int value, fada_Pos len)
+{
+	return memset(dest, value, len);
 }
\ No newline at end of file
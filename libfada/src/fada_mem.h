@@ -30,9 +30,12 @@
 
 
 void* fada_memalloc(fada_Pos len);
+void* fada_memalign(fada_Pos len, fada_Pos alignment);
 void fada_memfree(void* ptr);
 
 void* fada_memcopy(void* dest, void* src, fada_Pos len);
+void* fada_memmove(void* dest, void* src, fada_Pos len);
 void* fada_memzero(void* dest, fada_Pos len);
+void* fada_memset(void* dest, int value, fada_Pos len);
 
 #endif
\ No newline at end of file
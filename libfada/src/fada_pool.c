@@ -0,0 +1,175 @@
+/***********************************************************************************
+ * libfada - Free Audio Detection and Analyzation Library                          *
+ *                                                                                 *
+ * The zlib/libpng License                                                         *
+ * Copyright (c) 2013 Nathan Cousins                                               *
+ *                                                                                 *
+ * This software is provided 'as-is', without any express or implied warranty.     *
+ * In no event will the authors be held liable for any damages arising from the    *
+ * use of this software.                                                           *
+ *                                                                                 *
+ * Permission is granted to anyone to use this software for any purpose,           *
+ * including commercial applications, and to alter it and redistribute it freely,  *
+ * subject to the following restrictions:                                          *
+ *                                                                                 *
+ * 1. The origin of this software must not be misrepresented; you must not claim   *
+ *    that you wrote the original software. If you use this software in a product, *
+ *    an acknowledgment in the product documentation would be appreciated but is   *
+ *    not required.                                                                *
+ *                                                                                 *
+ * 2. Altered source versions must be plainly marked as such, and must not be      *
+ *    misrepresented as being the original software.                               *
+ *                                                                                 *
+ * 3. This notice may not be removed or altered from any source distribution.      *
+ ***********************************************************************************/
+
+#include "fada_pool.h"
+#include "fada_mem.h"
+
+
+//////////////////////////////////////////////////
+static unsigned int fada_getpoolclass(fada_Pos len)
+{
+	unsigned int c = 0;
+
+	// Smallest power of two holding len.
+	while (c < _FADA_POOL_CLASSES - 1 && ((fada_Pos)1 << c) < len)
+		c++;
+
+	return c;
+}
+
+
+//////////////////////////////////////////////////
+void fada_initpool(fada_Pool* p, fada_Pos capacity)
+{
+	unsigned int c;
+
+	p->chunks = NULL;
+	for (c = 0; c < _FADA_POOL_CLASSES; c++)
+		p->blocks[c] = NULL;
+
+	p->size = 0;
+	p->capacity = capacity;
+}
+
+
+//////////////////////////////////////////////////
+void fada_resizepool(fada_Pool* p, fada_Pos capacity)
+{
+	fada_PoolBlock* block;
+	fada_Chunk* chunk;
+	unsigned int c;
+
+	p->capacity = capacity;
+
+	// Release the largest sample blocks first.
+	for (c = _FADA_POOL_CLASSES; c-- > 0 && p->size > p->capacity; )
+	{
+		while (p->size > p->capacity && p->blocks[c])
+		{
+			block = p->blocks[c];
+			p->blocks[c] = block->next;
+			p->size -= (fada_Pos)1 << c;
+
+			fada_memfree(block);
+		}
+	}
+
+	while (p->size > p->capacity && p->chunks)
+	{
+		chunk = p->chunks;
+		p->chunks = chunk->next;
+		p->size -= sizeof(fada_Chunk);
+
+		fada_memfree(chunk);
+	}
+}
+
+
+//////////////////////////////////////////////////
+void fada_clearpool(fada_Pool* p)
+{
+	fada_Pos capacity = p->capacity;
+
+	fada_resizepool(p, 0);
+	p->capacity = capacity;
+}
+
+
+//////////////////////////////////////////////////
+fada_Chunk* fada_poolnewchunk(fada_Pool* p)
+{
+	fada_Chunk* chunk = p->chunks;
+
+	if (!chunk)
+		return fada_newchunk();
+
+	p->chunks = chunk->next;
+	p->size -= sizeof(fada_Chunk);
+
+	fada_resetchunk(chunk);
+
+	return chunk;
+}
+
+
+//////////////////////////////////////////////////
+void fada_poolclosechunk(fada_Pool* p, fada_Chunk* chunk)
+{
+	if (chunk->samples_copied)
+		fada_poolfree(p, chunk->samples, chunk->samples_size);
+
+	if (sizeof(fada_Chunk) > p->capacity - p->size)
+	{
+		fada_memfree(chunk);
+		return;
+	}
+
+	chunk->next = p->chunks;
+	p->chunks = chunk;
+	p->size += sizeof(fada_Chunk);
+}
+
+
+//////////////////////////////////////////////////
+void* fada_poolalloc(fada_Pool* p, fada_Pos* len)
+{
+	fada_PoolBlock* block;
+	unsigned int c = fada_getpoolclass(*len < sizeof(fada_PoolBlock) ? sizeof(fada_PoolBlock) : *len);
+	fada_Pos size = (fada_Pos)1 << c;
+
+	// Blocks that could never be kept by the pool are allocated at their exact size.
+	if (size < *len || size > p->capacity)
+		return fada_memalign(*len, FADA_ALIGNMENT);
+
+	*len = size;
+
+	block = p->blocks[c];
+	if (!block)
+		return fada_memalign(size, FADA_ALIGNMENT);
+
+	p->blocks[c] = block->next;
+	p->size -= size;
+
+	return block;
+}
+
+
+//////////////////////////////////////////////////
+void fada_poolfree(fada_Pool* p, void* ptr, fada_Pos len)
+{
+	fada_PoolBlock* block = (fada_PoolBlock*)ptr;
+	unsigned int c = fada_getpoolclass(len);
+
+	// Only blocks handed out at a class size can go back to the pool.
+	if (len < sizeof(fada_PoolBlock) || len != ((fada_Pos)1 << c) || len > p->capacity - p->size)
+	{
+		fada_memfree(ptr);
+		return;
+	}
+
+	block->next = p->blocks[c];
+	p->blocks[c] = block;
+	p->size += len;
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+/***********************************************************************************
+ * libfada - Free Audio Detection and Analyzation Library                          *
+ *                                                                                 *
+ * The zlib/libpng License                                                         *
+ * Copyright (c) 2013 Nathan Cousins                                               *
+ *                                                                                 *
+ * This software is provided 'as-is', without any express or implied warranty.     *
+ * In no event will the authors be held liable for any damages arising from the    *
+ * use of this software.                                                           *
+ *                                                                                 *
+ * Permission is granted to anyone to use this software for any purpose,           *
+ * including commercial applications, and to alter it and redistribute it freely,  *
+ * subject to the following restrictions:                                          *
+ *                                                                                 *
+ * 1. The origin of this software must not be misrepresented; you must not claim   *
+ *    that you wrote the original software. If you use this software in a product, *
+ *    an acknowledgment in the product documentation would be appreciated but is   *
+ *    not required.                                                                *
+ *                                                                                 *
+ * 2. Altered source versions must be plainly marked as such, and must not be      *
+ *    misrepresented as being the original software.                               *
+ *                                                                                 *
+ * 3. This notice may not be removed or altered from any source distribution.      *
+ ***********************************************************************************/
+
+#ifndef _FADA_POOL_H
+#define _FADA_POOL_H
+
+#include <fada/fada_def.h>
+#include "fada_chunk.h"
+
+// One size class for every power of two a fada_Pos can hold.
+#define _FADA_POOL_CLASSES (sizeof(fada_Pos) * 8)
+
+
+typedef struct fada_PoolBlock fada_PoolBlock;
+typedef struct fada_Pool fada_Pool;
+
+// Header written into a sample block while it waits in the pool.
+struct fada_PoolBlock
+{
+	fada_PoolBlock* next;
+};
+
+struct fada_Pool
+{
+	fada_Chunk* chunks;
+	fada_PoolBlock* blocks[_FADA_POOL_CLASSES];
+	fada_Pos size;
+	fada_Pos capacity;
+};
+
+void fada_initpool(fada_Pool* p, fada_Pos capacity);
+void fada_resizepool(fada_Pool* p, fada_Pos capacity);
+void fada_clearpool(fada_Pool* p);
+
+fada_Chunk* fada_poolnewchunk(fada_Pool* p);
+void fada_poolclosechunk(fada_Pool* p, fada_Chunk* chunk);
+
+// Allocate at least *len bytes, rounding *len up to the size class when the block can be pooled.
+void* fada_poolalloc(fada_Pool* p, fada_Pos* len);
+void fada_poolfree(fada_Pool* p, void* ptr, fada_Pos len);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,355 @@
+/***********************************************************************************
+ * libfada - Free Audio Detection and Analyzation Library                          *
+ *                                                                                 *
+ * The zlib/libpng License                                                         *
+ * Copyright (c) 2013 Nathan Cousins                                               *
+ *                                                                                 *
+ * This software is provided 'as-is', without any express or implied warranty.     *
+ * In no event will the authors be held liable for any damages arising from the    *
+ * use of this software.                                                           *
+ *                                                                                 *
+ * Permission is granted to anyone to use this software for any purpose,           *
+ * including commercial applications, and to alter it and redistribute it freely,  *
+ * subject to the following restrictions:                                          *
+ *                                                                                 *
+ * 1. The origin of this software must not be misrepresented; you must not claim   *
+ *    that you wrote the original software. If you use this software in a product, *
+ *    an acknowledgment in the product documentation would be appreciated but is   *
+ *    not required.                                                                *
+ *                                                                                 *
+ * 2. Altered source versions must be plainly marked as such, and must not be      *
+ *    misrepresented as being the original software.                               *
+ *                                                                                 *
+ * 3. This notice may not be removed or altered from any source distribution.      *
+ ***********************************************************************************/
+
+// Needed for posix_fadvise.
+#if !defined(_WIN32) && !defined(_DEFAULT_SOURCE)
+	#define _DEFAULT_SOURCE
+#endif
+
+#include <fada/fada.h>
+#include "fada_reader.h"
+#include "fada_mem.h"
+#include "fada_wav.h"
+
+#if defined(_WIN32)
+	#include <io.h>
+#else
+	#include <errno.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+// Size of the input that has no known end.
+#define _FADA_READER_UNBOUNDED ((fada_Pos)-1)
+
+// Largest amount passed to a single read() call.
+#define _FADA_READER_MAX_READ (1U << 30)
+
+// Only the fields of a "fmt " chunk up to the extensible sub-format are needed.
+#define _FADA_READER_FORMAT_SIZE 40
+
+
+//////////////////////////////////////////////////
+static fada_Pos fada_readfd(void* buffer, fada_Pos size, void* userdata)
+{
+	int fd = *(int*)userdata;
+
+	if (size > _FADA_READER_MAX_READ)
+		size = _FADA_READER_MAX_READ;
+
+#if defined(_WIN32)
+	{
+		int n = _read(fd, buffer, (unsigned int)size);
+		return (n > 0) ? (fada_Pos)n : 0;
+	}
+#else
+	for (;;)
+	{
+		ssize_t n = read(fd, buffer, (size_t)size);
+		if (n >= 0)
+			return (fada_Pos)n;
+		if (errno != EINTR)
+			return 0;
+	}
+#endif
+}
+
+
+//////////////////////////////////////////////////
+static fada_Pos fada_readinput(fada_Reader* r, void* buffer, fada_Pos size)
+{
+	unsigned char* dst = (unsigned char*)buffer;
+	fada_Pos total = 0, n;
+
+	if (size > r->remaining)
+		size = r->remaining;
+
+	// The callback may return less than asked for, so keep reading until the buffer is full or the input ends.
+	while (total < size)
+	{
+		n = r->read_func(&dst[total], size - total, r->userdata);
+		if (!n)
+			break;
+		total += n;
+	}
+
+	if (r->remaining != _FADA_READER_UNBOUNDED)
+		r->remaining -= total;
+
+	return total;
+}
+
+
+//////////////////////////////////////////////////
+static fada_Boolean fada_skipinput(fada_Reader* r, fada_Pos size)
+{
+	unsigned char scratch[256];
+	fada_Pos n;
+
+	// Callbacks cannot seek, so skipped chunks are read and thrown away.
+	while (size)
+	{
+		n = (size > sizeof(scratch)) ? sizeof(scratch) : size;
+		if (fada_readinput(r, scratch, n) != n)
+			return FADA_FALSE;
+		size -= n;
+	}
+
+	return FADA_TRUE;
+}
+
+
+//////////////////////////////////////////////////
+static fada_Pos fada_fillblock(fada_Reader* r, unsigned char* block)
+{
+	fada_Pos size = fada_readinput(r, block, r->block_frames * r->frame_size);
+
+	// A trailing partial frame is ignored.
+	return size - size % r->frame_size;
+}
+
+
+//////////////////////////////////////////////////
+static void fada_readahead(void* arg)
+{
+	fada_Reader* r = (fada_Reader*)arg;
+	fada_Pos size;
+
+	for (;;)
+	{
+		fada_waitsemaphore(r->free_blocks);
+		if (fada_atomicload(&r->stop))
+			break;
+
+		size = fada_fillblock(r, r->blocks[r->write_index]);
+		r->block_sizes[r->write_index] = size;
+		r->write_index ^= 1;
+
+		fada_postsemaphore(r->full_blocks);
+
+		// An empty block marks the end of the input.
+		if (!size)
+			break;
+	}
+}
+
+
+//////////////////////////////////////////////////
+fada_Error fada_readwavheader(fada_Reader* r, fada_TSample* sample_type, unsigned int* sample_rate, unsigned int* channels)
+{
+	unsigned char header[_FADA_WAV_HEADER_SIZE];
+	unsigned char fmt[_FADA_READER_FORMAT_SIZE];
+	fada_Pos len, n;
+	fada_Error err;
+	fada_Boolean has_format = FADA_FALSE;
+
+	if (fada_readinput(r, header, _FADA_WAV_HEADER_SIZE) != _FADA_WAV_HEADER_SIZE || !fada_iswavheader(header))
+		return FADA_ERROR_INVALID_FILE;
+
+	// Walk the chunks until the sample data, which must come after the format.
+	while (fada_readinput(r, header, _FADA_WAV_CHUNK_SIZE) == _FADA_WAV_CHUNK_SIZE)
+	{
+		len = fada_readle32(&header[4]);
+
+		if (fada_isfourcc(header, "data"))
+		{
+			if (!has_format)
+				return FADA_ERROR_INVALID_FILE;
+
+			// Streamed recordings leave the size unset, so their samples run to the end of the input.
+			if (len && len != 0xFFFFFFFFU)
+				r->remaining = len;
+
+			return FADA_ERROR_SUCCESS;
+		}
+
+		if (fada_isfourcc(header, "fmt "))
+		{
+			n = (len > sizeof(fmt)) ? sizeof(fmt) : len;
+			if (fada_readinput(r, fmt, n) != n)
+				return FADA_ERROR_INVALID_FILE;
+
+			err = fada_parsewavformat(fmt, n, sample_type, sample_rate, channels);
+			if (err != FADA_ERROR_SUCCESS)
+				return err;
+
+			has_format = FADA_TRUE;
+			len -= n;
+		}
+
+		if (!fada_skipinput(r, len + (len & 1)))
+			return FADA_ERROR_INVALID_FILE;
+	}
+
+	return FADA_ERROR_INVALID_FILE;
+}
+
+
+//////////////////////////////////////////////////
+fada_Error fada_startreader(fada_Reader* r, fada_Pos frame_size)
+{
+	unsigned int i, count = r->read_ahead ? 2 : 1;
+
+	r->frame_size = frame_size;
+
+	for (i = 0; i < count; ++i)
+	{
+		r->blocks[i] = (unsigned char*)fada_memalign(r->block_frames * frame_size, FADA_ALIGNMENT);
+		if (!r->blocks[i])
+			return FADA_ERROR_NOT_ENOUGH_MEMORY;
+	}
+
+	if (r->read_ahead)
+	{
+		r->free_blocks = fada_newsemaphore(2);
+		r->full_blocks = fada_newsemaphore(0);
+		if (!r->free_blocks || !r->full_blocks)
+			return FADA_ERROR_NOT_ENOUGH_MEMORY;
+
+		r->thread = fada_newthread(fada_readahead, r);
+		if (!r->thread)
+			return FADA_ERROR_NOT_ENOUGH_MEMORY;
+	}
+
+	return FADA_ERROR_SUCCESS;
+}
+
+
+//////////////////////////////////////////////////
+fada_Pos fada_acquireblock(fada_Reader* r, const void** data)
+{
+	if (!r->pending)
+	{
+		if (r->read_ahead)
+			fada_waitsemaphore(r->full_blocks);
+		else
+			r->block_sizes[0] = fada_fillblock(r, r->blocks[0]);
+
+		r->pending = FADA_TRUE;
+	}
+
+	*data = r->blocks[r->read_index];
+	return r->block_sizes[r->read_index];
+}
+
+
+//////////////////////////////////////////////////
+void fada_releaseblock(fada_Reader* r)
+{
+	r->pending = FADA_FALSE;
+
+	if (r->read_ahead)
+	{
+		r->read_index ^= 1;
+		fada_postsemaphore(r->free_blocks);
+	}
+}
+
+
+//////////////////////////////////////////////////
+FADA_API fada_Reader* fada_newreader(fada_ReadFunc read_func, void* userdata, fada_Pos block_frames, fada_Boolean read_ahead)
+{
+	fada_Reader* r;
+
+	if (!read_func)
+		return NULL;
+
+	r = (fada_Reader*)fada_memalloc(sizeof(fada_Reader));
+	if (!r)
+		return NULL;
+
+	r->read_func = read_func;
+	r->userdata = userdata;
+	r->fd = -1;
+
+	r->block_frames = block_frames ? block_frames : FADA_DEFAULT_BLOCKFRAMES;
+	r->frame_size = 0;
+	r->remaining = _FADA_READER_UNBOUNDED;
+
+	r->blocks[0] = NULL;
+	r->blocks[1] = NULL;
+	r->block_sizes[0] = 0;
+	r->block_sizes[1] = 0;
+	r->read_index = 0;
+	r->write_index = 0;
+	r->pending = FADA_FALSE;
+
+	r->read_ahead = read_ahead;
+	r->stop = 0;
+	r->thread = NULL;
+	r->free_blocks = NULL;
+	r->full_blocks = NULL;
+
+	return r;
+}
+
+
+//////////////////////////////////////////////////
+FADA_API fada_Reader* fada_newreader_fd(int fd, fada_Pos block_frames, fada_Boolean read_ahead)
+{
+	fada_Reader* r;
+
+	if (fd < 0)
+		return NULL;
+
+	r = fada_newreader(fada_readfd, NULL, block_frames, read_ahead);
+	if (!r)
+		return NULL;
+
+	r->fd = fd;
+	r->userdata = &r->fd;
+
+#if defined(POSIX_FADV_SEQUENTIAL)
+	// Let the kernel read further ahead than usual. Fails harmlessly on pipes.
+	posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+	return r;
+}
+
+
+//////////////////////////////////////////////////
+FADA_API void fada_closereader(fada_Reader* r)
+{
+	if (!r)
+		return;
+
+	// Wake the read-ahead thread so it sees the stop flag. It finishes its current read first.
+	if (r->thread)
+	{
+		fada_atomicstore(&r->stop, 1);
+		fada_postsemaphore(r->free_blocks);
+		fada_jointhread(r->thread);
+	}
+
+	if (r->free_blocks)
+		fada_closesemaphore(r->free_blocks);
+	if (r->full_blocks)
+		fada_closesemaphore(r->full_blocks);
+
+	fada_memfree(r->blocks[0]);
+	fada_memfree(r->blocks[1]);
+	fada_memfree(r);
+}
\ No newline at end of file
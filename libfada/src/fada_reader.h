@@ -0,0 +1,69 @@
+/***********************************************************************************
+ * libfada - Free Audio Detection and Analyzation Library                          *
+ *                                                                                 *
+ * The zlib/libpng License                                                         *
+ * Copyright (c) 2013 Nathan Cousins                                               *
+ *                                                                                 *
+ * This software is provided 'as-is', without any express or implied warranty.     *
+ * In no event will the authors be held liable for any damages arising from the    *
+ * use of this software.                                                           *
+ *                                                                                 *
+ * Permission is granted to anyone to use this software for any purpose,           *
+ * including commercial applications, and to alter it and redistribute it freely,  *
+ * subject to the following restrictions:                                          *
+ *                                                                                 *
+ * 1. The origin of this software must not be misrepresented; you must not claim   *
+ *    that you wrote the original software. If you use this software in a product, *
+ *    an acknowledgment in the product documentation would be appreciated but is   *
+ *    not required.                                                                *
+ *                                                                                 *
+ * 2. Altered source versions must be plainly marked as such, and must not be      *
+ *    misrepresented as being the original software.                               *
+ *                                                                                 *
+ * 3. This notice may not be removed or altered from any source distribution.      *
+ ***********************************************************************************/
+
+#ifndef _FADA_READER_H
+#define _FADA_READER_H
+
+#include <fada/fada_def.h>
+#include "fada_atomic.h"
+#include "fada_thread.h"
+
+
+struct fada_Reader
+{
+	fada_ReadFunc read_func;
+	void* userdata;
+	int fd;
+
+	fada_Pos block_frames;
+	fada_Pos frame_size;
+	fada_Pos remaining;
+
+	// Two blocks are used with read-ahead, so one can be filled while the other is pushed.
+	unsigned char* blocks[2];
+	fada_Pos block_sizes[2];
+	unsigned int read_index;
+	unsigned int write_index;
+	fada_Boolean pending;
+
+	fada_Boolean read_ahead;
+	fada_AtomicPos stop;
+	fada_Thread* thread;
+	fada_Semaphore* free_blocks;
+	fada_Semaphore* full_blocks;
+};
+
+// Read the WAV header from the input, leaving it positioned at the first sample.
+fada_Error fada_readwavheader(fada_Reader* r, fada_TSample* sample_type, unsigned int* sample_rate, unsigned int* channels);
+
+// Allocate the blocks for frames of frame_size bytes and start reading ahead if requested.
+fada_Error fada_startreader(fada_Reader* r, fada_Pos frame_size);
+
+// Get the next block of whole frames. Returns its size in bytes, or 0 at the end of the input.
+// The block stays valid and is returned again until it is released.
+fada_Pos fada_acquireblock(fada_Reader* r, const void** data);
+void fada_releaseblock(fada_Reader* r);
+
+#endif
\ No newline at end of file
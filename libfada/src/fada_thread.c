@@ -0,0 +1,215 @@
+/***********************************************************************************
+ * libfada - Free Audio Detection and Analyzation Library                          *
+ *                                                                                 *
+ * The zlib/libpng License                                                         *
+ * Copyright (c) 2013 Nathan Cousins                                               *
+ *                                                                                 *
+ * This software is provided 'as-is', without any express or implied warranty.     *
+ * In no event will the authors be held liable for any damages arising from the    *
+ * use of this software.                                                           *
+ *                                                                                 *
+ * Permission is granted to anyone to use this software for any purpose,           *
+ * including commercial applications, and to alter it and redistribute it freely,  *
+ * subject to the following restrictions:                                          *
+ *                                                                                 *
+ * 1. The origin of this software must not be misrepresented; you must not claim   *
+ *    that you wrote the original software. If you use this software in a product, *
+ *    an acknowledgment in the product documentation would be appreciated but is   *
+ *    not required.                                                                *
+ *                                                                                 *
+ * 2. Altered source versions must be plainly marked as such, and must not be      *
+ *    misrepresented as being the original software.                               *
+ *                                                                                 *
+ * 3. This notice may not be removed or altered from any source distribution.      *
+ ***********************************************************************************/
+
+#include "fada_thread.h"
+#include "fada_mem.h"
+
+#if defined(_WIN32)
+	#define WIN32_LEAN_AND_MEAN
+	#include <windows.h>
+#else
+	#include <pthread.h>
+	#include <unistd.h>
+#endif
+
+
+struct fada_Thread
+{
+#if defined(_WIN32)
+	HANDLE handle;
+#else
+	pthread_t handle;
+#endif
+	fada_ThreadFunc func;
+	void* arg;
+};
+
+
+struct fada_Semaphore
+{
+#if defined(_WIN32)
+	HANDLE handle;
+#else
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+	unsigned int count;
+#endif
+};
+
+
+//////////////////////////////////////////////////
+#if defined(_WIN32)
+static DWORD WINAPI fada_threadmain(LPVOID param)
+{
+	fada_Thread* t = (fada_Thread*)param;
+	t->func(t->arg);
+	return 0;
+}
+#else
+static void* fada_threadmain(void* param)
+{
+	fada_Thread* t = (fada_Thread*)param;
+	t->func(t->arg);
+	return NULL;
+}
+#endif
+
+
+//////////////////////////////////////////////////
+fada_Thread* fada_newthread(fada_ThreadFunc func, void* arg)
+{
+	fada_Thread* t = (fada_Thread*)fada_memalloc(sizeof(fada_Thread));
+
+	if (!t)
+		return NULL;
+
+	t->func = func;
+	t->arg = arg;
+
+#if defined(_WIN32)
+	t->handle = CreateThread(NULL, 0, fada_threadmain, t, 0, NULL);
+	if (!t->handle)
+	{
+		fada_memfree(t);
+		return NULL;
+	}
+#else
+	if (pthread_create(&t->handle, NULL, fada_threadmain, t) != 0)
+	{
+		fada_memfree(t);
+		return NULL;
+	}
+#endif
+
+	return t;
+}
+
+
+//////////////////////////////////////////////////
+void fada_jointhread(fada_Thread* t)
+{
+#if defined(_WIN32)
+	WaitForSingleObject(t->handle, INFINITE);
+	CloseHandle(t->handle);
+#else
+	pthread_join(t->handle, NULL);
+#endif
+
+	fada_memfree(t);
+}
+
+
+//////////////////////////////////////////////////
+unsigned int fada_getcpucount()
+{
+#if defined(_WIN32)
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return info.dwNumberOfProcessors ? info.dwNumberOfProcessors : 1;
+#else
+	long n = sysconf(_SC_NPROCESSORS_ONLN);
+	return (n > 0) ? (unsigned int)n : 1;
+#endif
+}
+
+
+//////////////////////////////////////////////////
+fada_Semaphore* fada_newsemaphore(unsigned int count)
+{
+	fada_Semaphore* s = (fada_Semaphore*)fada_memalloc(sizeof(fada_Semaphore));
+
+	if (!s)
+		return NULL;
+
+#if defined(_WIN32)
+	s->handle = CreateSemaphore(NULL, (LONG)count, 0x7FFFFFFF, NULL);
+	if (!s->handle)
+	{
+		fada_memfree(s);
+		return NULL;
+	}
+#else
+	// POSIX unnamed semaphores are not available everywhere, so build one from a mutex and condition variable.
+	s->count = count;
+
+	if (pthread_mutex_init(&s->mutex, NULL) != 0)
+	{
+		fada_memfree(s);
+		return NULL;
+	}
+
+	if (pthread_cond_init(&s->cond, NULL) != 0)
+	{
+		pthread_mutex_destroy(&s->mutex);
+		fada_memfree(s);
+		return NULL;
+	}
+#endif
+
+	return s;
+}
+
+
+//////////////////////////////////////////////////
+void fada_closesemaphore(fada_Semaphore* s)
+{
+#if defined(_WIN32)
+	CloseHandle(s->handle);
+#else
+	pthread_cond_destroy(&s->cond);
+	pthread_mutex_destroy(&s->mutex);
+#endif
+
+	fada_memfree(s);
+}
+
+
+//////////////////////////////////////////////////
+void fada_waitsemaphore(fada_Semaphore* s)
+{
+#if defined(_WIN32)
+	WaitForSingleObject(s->handle, INFINITE);
+#else
+	pthread_mutex_lock(&s->mutex);
+	while (!s->count)
+		pthread_cond_wait(&s->cond, &s->mutex);
+	--s->count;
+	pthread_mutex_unlock(&s->mutex);
+#endif
+}
+
+
+//////////////////////////////////////////////////
+void fada_postsemaphore(fada_Semaphore* s)
+{
+#if defined(_WIN32)
+	ReleaseSemaphore(s->handle, 1, NULL);
+#else
+	pthread_mutex_lock(&s->mutex);
+	++s->count;
+	pthread_cond_signal(&s->cond);
+	pthread_mutex_unlock(&s->mutex);
+#endif
+}
\ No newline at end of file
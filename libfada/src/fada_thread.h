@@ -0,0 +1,57 @@
+/***********************************************************************************
+ * libfada - Free Audio Detection and Analyzation Library                          *
+ *                                                                                 *
+ * The zlib/libpng License                                                         *
+ * Copyright (c) 2013 Nathan Cousins                                               *
+ *                                                                                 *
+ * This software is provided 'as-is', without any express or implied warranty.     *
+ * In no event will the authors be held liable for any damages arising from the    *
+ * use of this software.                                                           *
+ *                                                                                 *
+ * Permission is granted to anyone to use this software for any purpose,           *
+ * including commercial applications, and to alter it and redistribute it freely,  *
+ * subject to the following restrictions:                                          *
+ *                                                                                 *
+ * 1. The origin of this software must not be misrepresented; you must not claim   *
+ *    that you wrote the original software. If you use this software in a product, *
+ *    an acknowledgment in the product documentation would be appreciated but is   *
+ *    not required.                                                                *
+ *                                                                                 *
+ * 2. Altered source versions must be plainly marked as such, and must not be      *
+ *    misrepresented as being the original software.                               *
+ *                                                                                 *
+ * 3. This notice may not be removed or altered from any source distribution.      *
+ ***********************************************************************************/
+
+#ifndef _FADA_THREAD_H
+#define _FADA_THREAD_H
+
+#include <fada/fada_def.h>
+
+
+typedef struct fada_Thread fada_Thread;
+typedef void (*fada_ThreadFunc)(void* arg);
+
+// Start running func(arg) on a new thread. Returns NULL if the thread could not be started.
+fada_Thread* fada_newthread(fada_ThreadFunc func, void* arg);
+
+// Wait for the thread to finish and release it.
+void fada_jointhread(fada_Thread* t);
+
+// Number of processors available to run threads on.
+unsigned int fada_getcpucount();
+
+
+typedef struct fada_Semaphore fada_Semaphore;
+
+// Create a counting semaphore. Returns NULL if it could not be created.
+fada_Semaphore* fada_newsemaphore(unsigned int count);
+void fada_closesemaphore(fada_Semaphore* s);
+
+// Block until the count is above zero, then decrement it.
+void fada_waitsemaphore(fada_Semaphore* s);
+
+// Increment the count, waking one waiting thread.
+void fada_postsemaphore(fada_Semaphore* s);
+
+#endif
\ No newline at end of file
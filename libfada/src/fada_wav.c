@@ -0,0 +1,159 @@
+/***********************************************************************************
+ * libfada - Free Audio Detection and Analyzation Library                          *
+ *                                                                                 *
+ * The zlib/libpng License                                                         *
+ * Copyright (c) 2013 Nathan Cousins                                               *
+ *                                                                                 *
+ * This software is provided 'as-is', without any express or implied warranty.     *
+ * In no event will the authors be held liable for any damages arising from the    *
+ * use of this software.                                                           *
+ *                                                                                 *
+ * Permission is granted to anyone to use this software for any purpose,           *
+ * including commercial applications, and to alter it and redistribute it freely,  *
+ * subject to the following restrictions:                                          *
+ *                                                                                 *
+ * 1. The origin of this software must not be misrepresented; you must not claim   *
+ *    that you wrote the original software. If you use this software in a product, *
+ *    an acknowledgment in the product documentation would be appreciated but is   *
+ *    not required.                                                                *
+ *                                                                                 *
+ * 2. Altered source versions must be plainly marked as such, and must not be      *
+ *    misrepresented as being the original software.                               *
+ *                                                                                 *
+ * 3. This notice may not be removed or altered from any source distribution.      *
+ ***********************************************************************************/
+
+#include "fada_wav.h"
+
+#define _FADA_WAV_FORMAT_PCM        0x0001
+#define _FADA_WAV_FORMAT_FLOAT      0x0003
+#define _FADA_WAV_FORMAT_EXTENSIBLE 0xFFFE
+
+
+//////////////////////////////////////////////////
+unsigned int fada_readle16(const unsigned char* p)
+{
+	return (unsigned int)p[0] | ((unsigned int)p[1] << 8);
+}
+
+
+//////////////////////////////////////////////////
+unsigned int fada_readle32(const unsigned char* p)
+{
+	return (unsigned int)p[0] | ((unsigned int)p[1] << 8) | ((unsigned int)p[2] << 16) | ((unsigned int)p[3] << 24);
+}
+
+
+//////////////////////////////////////////////////
+fada_Boolean fada_isfourcc(const unsigned char* p, const char* id)
+{
+	return p[0] == id[0] && p[1] == id[1] && p[2] == id[2] && p[3] == id[3];
+}
+
+
+//////////////////////////////////////////////////
+fada_Boolean fada_iswavheader(const unsigned char* header)
+{
+	return fada_isfourcc(header, "RIFF") && fada_isfourcc(&header[8], "WAVE");
+}
+
+
+//////////////////////////////////////////////////
+fada_Error fada_parsewavformat(const unsigned char* fmt, fada_Pos len, fada_TSample* sample_type, unsigned int* sample_rate, unsigned int* channels)
+{
+	unsigned int tag, bits;
+
+	if (len < 16)
+		return FADA_ERROR_INVALID_FILE;
+
+	tag = fada_readle16(fmt);
+	*channels = fada_readle16(&fmt[2]);
+	*sample_rate = fada_readle32(&fmt[4]);
+	bits = fada_readle16(&fmt[14]);
+
+	// Extensible formats keep the actual format tag at the start of the sub-format GUID.
+	if (tag == _FADA_WAV_FORMAT_EXTENSIBLE)
+	{
+		if (len < 40)
+			return FADA_ERROR_INVALID_FILE;
+		tag = fada_readle16(&fmt[24]);
+	}
+
+	// Samples must be packed without padding.
+	if (fada_readle16(&fmt[12]) * 8 != *channels * bits)
+		return FADA_ERROR_INVALID_TYPE;
+
+	*sample_type = FADA_TSAMPLE_NOTSET;
+
+	if (tag == _FADA_WAV_FORMAT_PCM)
+	{
+		switch (bits)
+		{
+			// 8-bit WAV samples are unsigned, all wider ones signed.
+			case 8:  *sample_type = FADA_TSAMPLE_UINT8; break;
+			case 16: *sample_type = FADA_TSAMPLE_INT16; break;
+			case 24: *sample_type = FADA_TSAMPLE_INT24; break;
+			case 32: *sample_type = FADA_TSAMPLE_INT32; break;
+			case 64: *sample_type = FADA_TSAMPLE_INT64; break;
+		}
+	}
+	else if (tag == _FADA_WAV_FORMAT_FLOAT)
+	{
+		switch (bits)
+		{
+			case 32: *sample_type = FADA_TSAMPLE_FLOAT32; break;
+			case 64: *sample_type = FADA_TSAMPLE_FLOAT64; break;
+		}
+	}
+
+	if (*sample_type == FADA_TSAMPLE_NOTSET)
+		return FADA_ERROR_INVALID_TYPE;
+
+	return FADA_ERROR_SUCCESS;
+}
+
+
+//////////////////////////////////////////////////
+fada_Error fada_parsewav(const unsigned char* data, fada_Pos size, fada_TSample* sample_type, unsigned int* sample_rate, unsigned int* channels, fada_Pos* data_offset, fada_Pos* data_size)
+{
+	fada_Pos pos, len;
+	fada_Error err;
+	fada_Boolean has_format = FADA_FALSE;
+
+	if (size < _FADA_WAV_HEADER_SIZE || !fada_iswavheader(data))
+		return FADA_ERROR_INVALID_FILE;
+
+	// Walk the chunks until the sample data, which must come after the format.
+	// A chunk of odd length at the very end may lack its pad byte, leaving pos one past the end.
+	for (pos = _FADA_WAV_HEADER_SIZE; pos <= size && size - pos >= _FADA_WAV_CHUNK_SIZE; pos += len + (len & 1))
+	{
+		len = fada_readle32(&data[pos + 4]);
+		pos += _FADA_WAV_CHUNK_SIZE;
+
+		if (fada_isfourcc(&data[pos - _FADA_WAV_CHUNK_SIZE], "data"))
+		{
+			if (!has_format)
+				return FADA_ERROR_INVALID_FILE;
+
+			// Recorders that were cut off may leave the size unset or too large.
+			*data_offset = pos;
+			*data_size = (len > size - pos) ? size - pos : len;
+
+			return FADA_ERROR_SUCCESS;
+		}
+
+		if (len > size - pos)
+			return FADA_ERROR_INVALID_FILE;
+
+		if (fada_isfourcc(&data[pos - _FADA_WAV_CHUNK_SIZE], "fmt "))
+		{
+			err = fada_parsewavformat(&data[pos], len, sample_type, sample_rate, channels);
+			if (err != FADA_ERROR_SUCCESS)
+				return err;
+
+			has_format = FADA_TRUE;
+		}
+	}
+
+	return FADA_ERROR_INVALID_FILE;
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+/***********************************************************************************
+ * libfada - Free Audio Detection and Analyzation Library                          *
+ *                                                                                 *
+ * The zlib/libpng License                                                         *
+ * Copyright (c) 2013 Nathan Cousins                                               *
+ *                                                                                 *
+ * This software is provided 'as-is', without any express or implied warranty.     *
+ * In no event will the authors be held liable for any damages arising from the    *
+ * use of this software.                                                           *
+ *                                                                                 *
+ * Permission is granted to anyone to use this software for any purpose,           *
+ * including commercial applications, and to alter it and redistribute it freely,  *
+ * subject to the following restrictions:                                          *
+ *                                                                                 *
+ * 1. The origin of this software must not be misrepresented; you must not claim   *
+ *    that you wrote the original software. If you use this software in a product, *
+ *    an acknowledgment in the product documentation would be appreciated but is   *
+ *    not required.                                                                *
+ *                                                                                 *
+ * 2. Altered source versions must be plainly marked as such, and must not be      *
+ *    misrepresented as being the original software.                               *
+ *                                                                                 *
+ * 3. This notice may not be removed or altered from any source distribution.      *
+ ***********************************************************************************/
+
+#ifndef _FADA_WAV_H
+#define _FADA_WAV_H
+
+#include <fada/fada_def.h>
+
+// Size of the RIFF header and of each chunk header in a WAV file.
+#define _FADA_WAV_HEADER_SIZE 12
+#define _FADA_WAV_CHUNK_SIZE  8
+
+
+// Little-endian reads from a byte buffer.
+unsigned int fada_readle16(const unsigned char* p);
+unsigned int fada_readle32(const unsigned char* p);
+
+// Compare a four-character chunk ID.
+fada_Boolean fada_isfourcc(const unsigned char* p, const char* id);
+
+// Check the RIFF/WAVE header at the start of a file.
+fada_Boolean fada_iswavheader(const unsigned char* header);
+
+// Translate the body of a "fmt " chunk into a sample type, sample rate and channel count.
+fada_Error fada_parsewavformat(const unsigned char* fmt, fada_Pos len, fada_TSample* sample_type, unsigned int* sample_rate, unsigned int* channels);
+
+// Find the format and the sample data of a WAV file held in memory.
+fada_Error fada_parsewav(const unsigned char* data, fada_Pos size, fada_TSample* sample_type, unsigned int* sample_rate, unsigned int* channels, fada_Pos* data_offset, fada_Pos* data_size);
+
+#endif
\ No newline at end of file
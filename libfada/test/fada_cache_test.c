@@ -0,0 +1,136 @@
+/***********************************************************************************
+ * libfada - Free Audio Detection and Analyzation Library                          *
+ *                                                                                 *
+ * The zlib/libpng License                                                         *
+ * Copyright (c) 2013 Nathan Cousins                                               *
+ *                                                                                 *
+ * This software is provided 'as-is', without any express or implied warranty.     *
+ * In no event will the authors be held liable for any damages arising from the    *
+ * use of this software.                                                           *
+ *                                                                                 *
+ * Permission is granted to anyone to use this software for any purpose,           *
+ * including commercial applications, and to alter it and redistribute it freely,  *
+ * subject to the following restrictions:                                          *
+ *                                                                                 *
+ * 1. The origin of this software must not be misrepresented; you must not claim   *
+ *    that you wrote the original software. If you use this software in a product, *
+ *    an acknowledgment in the product documentation would be appreciated but is   *
+ *    not required.                                                                *
+ *                                                                                 *
+ * 2. Altered source versions must be plainly marked as such, and must not be      *
+ *    misrepresented as being the original software.                               *
+ *                                                                                 *
+ * 3. This notice may not be removed or altered from any source distribution.      *
+ ***********************************************************************************/
+
+// Checks that rebinding a manager after changing its sample cache analyses the same as a freshly bound one.
+// Rebinding with the same window size must still resize the window buffer when the stored sample size changes.
+// Build from the libfada directory and run; exits with a non-zero status on a failure:
+//
+//   cc -std=gnu99 -g -fsanitize=address -DFADA_STATIC -DFADA_BUILD -Iinclude -Isrc test/fada_cache_test.c src/*.c -lm -lpthread -o fada_cache_test
+
+#include <fada/fada.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+
+#define _FADA_TEST_CHUNK  20000
+#define _FADA_TEST_CHUNKS 2
+
+
+static short fada_testsamples[_FADA_TEST_CHUNK * _FADA_TEST_CHUNKS];
+
+
+//////////////////////////////////////////////////
+static fada_Error fada_bindtest(fada_Manager* m)
+{
+	fada_Error err;
+	int i;
+
+	err = fada_bindstream(m, FADA_TSAMPLE_INT16, 44100, 2);
+
+	for (i = 0; i < _FADA_TEST_CHUNKS && err == FADA_ERROR_SUCCESS; ++i)
+		err = fada_pushsamples(m, &fada_testsamples[i * _FADA_TEST_CHUNK], _FADA_TEST_CHUNK, FADA_FALSE);
+
+	return err;
+}
+
+
+//////////////////////////////////////////////////
+static int fada_testrebind(const char* name, fada_TSample first_cache, fada_TSample cache)
+{
+	fada_Manager* m = fada_newmanager();
+	fada_Manager* ref = fada_newmanager();
+	fada_Res beat, ref_beat, bass, ref_bass;
+	fada_Boolean more;
+	int windows = 0, failed = 0;
+
+	// Bind once with the first cache, then switch the cache and bind again.
+	fada_setsamplecache(m, first_cache);
+	fada_setsamplecache(ref, cache);
+
+	if (fada_bindstream(m, FADA_TSAMPLE_INT16, 44100, 2) != FADA_ERROR_SUCCESS ||
+		fada_setsamplecache(m, cache) != FADA_ERROR_SUCCESS ||
+		fada_bindtest(m) != FADA_ERROR_SUCCESS ||
+		fada_bindtest(ref) != FADA_ERROR_SUCCESS)
+	{
+		printf("FAIL %s: binding failed\n", name);
+		failed = 1;
+	}
+
+	while (!failed)
+	{
+		if (fada_calcbeat(m, &beat) != FADA_ERROR_SUCCESS || fada_calcbeat(ref, &ref_beat) != FADA_ERROR_SUCCESS ||
+			fada_calcbass(m, &bass) != FADA_ERROR_SUCCESS || fada_calcbass(ref, &ref_bass) != FADA_ERROR_SUCCESS)
+		{
+			printf("FAIL %s: analysis failed at window %d\n", name, windows);
+			failed = 1;
+		}
+		else if (beat != ref_beat || bass != ref_bass || fada_getnormalizer(m) != fada_getnormalizer(ref))
+		{
+			printf("FAIL %s: window %d differs, beat %g/%g bass %g/%g\n", name, windows, beat, ref_beat, bass, ref_bass);
+			failed = 1;
+		}
+
+		++windows;
+
+		more = fada_continue(m, 512);
+		if (more != fada_continue(ref, 512))
+		{
+			printf("FAIL %s: streams end after different windows\n", name);
+			failed = 1;
+		}
+		else if (!more)
+			break;
+	}
+
+	fada_closemanager(m);
+	fada_closemanager(ref);
+
+	if (!failed)
+		printf("ok   %s (%d windows)\n", name, windows);
+
+	return failed;
+}
+
+
+//////////////////////////////////////////////////
+int main()
+{
+	int failed = 0, i;
+
+	for (i = 0; i < _FADA_TEST_CHUNK * _FADA_TEST_CHUNKS; ++i)
+		fada_testsamples[i] = (short)(sin(i * 0.01) * 12000. + (rand() % 8000) - 4000);
+
+	// The stored samples grow from 2 to 8 bytes while the window size stays the same.
+	failed |= fada_testrebind("rebind with float64 cache", FADA_TSAMPLE_NOTSET, FADA_TSAMPLE_FLOAT64);
+	failed |= fada_testrebind("rebind with float32 cache", FADA_TSAMPLE_NOTSET, FADA_TSAMPLE_FLOAT32);
+	failed |= fada_testrebind("rebind from float32 to float64 cache", FADA_TSAMPLE_FLOAT32, FADA_TSAMPLE_FLOAT64);
+
+	// And shrink back again.
+	failed |= fada_testrebind("rebind without cache", FADA_TSAMPLE_FLOAT64, FADA_TSAMPLE_NOTSET);
+
+	return failed;
+}
\ No newline at end of file
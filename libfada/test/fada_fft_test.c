@@ -0,0 +1,310 @@
+/***********************************************************************************
+ * libfada - Free Audio Detection and Analyzation Library                          *
+ *                                                                                 *
+ * The zlib/libpng License                                                         *
+ * Copyright (c) 2013 Nathan Cousins                                               *
+ *                                                                                 *
+ * This software is provided 'as-is', without any express or implied warranty.     *
+ * In no event will the authors be held liable for any damages arising from the    *
+ * use of this software.                                                           *
+ *                                                                                 *
+ * Permission is granted to anyone to use this software for any purpose,           *
+ * including commercial applications, and to alter it and redistribute it freely,  *
+ * subject to the following restrictions:                                          *
+ *                                                                                 *
+ * 1. The origin of this software must not be misrepresented; you must not claim   *
+ *    that you wrote the original software. If you use this software in a product, *
+ *    an acknowledgment in the product documentation would be appreciated but is   *
+ *    not required.                                                                *
+ *                                                                                 *
+ * 2. Altered source versions must be plainly marked as such, and must not be      *
+ *    misrepresented as being the original software.                               *
+ *                                                                                 *
+ * 3. This notice may not be removed or altered from any source distribution.      *
+ ***********************************************************************************/
+// Compares every butterfly kernel this CPU supports against the scalar reference kernel, on the twiddle tables
+// fada_newfftplan builds, then checks the whole real-input transform against a naive DFT.
+// Build from the libfada directory and run; exits with a non-zero status on a mismatch:
+//
+//   cc -std=gnu99 -O2 -DFADA_STATIC -DFADA_BUILD -Iinclude -Isrc test/fada_fft_test.c src/*.c -lm -lpthread -o fada_fft_test
+
+#include <fada/fada.h>
+#include "fada_calc.h"
+#include "fada_fft.h"
+#include "fada_fftplan.h"
+#include "fada_mem.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Largest number of complex values transformed.
+#define _FADA_TEST_MAX_SIZE 8192
+
+// Largest real transform checked against the naive DFT, which takes quadratic time.
+#define _FADA_TEST_MAX_DFT_SIZE 4096
+
+// Allowed difference to the scalar kernel, relative to the largest reference magnitude.
+#define _FADA_TEST_TOLERANCE   1e-12
+#define _FADA_TEST_TOLERANCE32 1e-5f
+
+// Allowed difference to the naive DFT, relative to the sum of input magnitudes, which bounds every bin.
+#define _FADA_TEST_DFT_TOLERANCE   1e-12
+#define _FADA_TEST_DFT_TOLERANCE32 1e-6
+
+#define _FADA_TEST_PI 3.1415926535897932384626433832795028842
+
+
+//////////////////////////////////////////////////
+static int fada_testbutterflies(const char* name, fada_FFTButterflies kernel, const fada_Res* input, fada_Res* ref, fada_Res* out)
+{
+	fada_FFTPlan* plan;
+	unsigned int n, i;
+	fada_Res peak, diff;
+	int failed = 0;
+
+	for (n = 1; n <= _FADA_TEST_MAX_SIZE; n <<= 1)
+	{
+		// Real transforms of 2n values run the butterflies on n complex values.
+		plan = fada_newfftplan(2 * n);
+		if (!plan)
+		{
+			printf("FAIL %s n=%u: could not create the plan\n", name, n);
+			return 1;
+		}
+
+		for (i = 0; i < 2*n; ++i)
+			ref[i] = out[i] = input[i];
+
+		fada_butterflies_scalar(ref, plan->twiddles, n);
+		kernel(out, plan->twiddles, n);
+
+		fada_closefftplan(plan);
+
+		peak = 1.;
+		diff = 0.;
+		for (i = 0; i < 2*n; ++i)
+		{
+			if (fabs(ref[i]) > peak)
+				peak = fabs(ref[i]);
+			if (fabs(out[i] - ref[i]) > diff)
+				diff = fabs(out[i] - ref[i]);
+		}
+
+		if (diff > _FADA_TEST_TOLERANCE * peak)
+		{
+			printf("FAIL %s n=%u: difference %g, peak %g\n", name, n, diff, peak);
+			failed = 1;
+		}
+	}
+
+	if (!failed)
+		printf("ok   %s\n", name);
+
+	return failed;
+}
+
+
+//////////////////////////////////////////////////
+static int fada_testbutterflies32(const char* name, fada_FFTButterflies32 kernel, const float* input, float* ref, float* out)
+{
+	fada_FFTPlan* plan;
+	unsigned int n, i;
+	float peak, diff;
+	int failed = 0;
+
+	for (n = 1; n <= _FADA_TEST_MAX_SIZE; n <<= 1)
+	{
+		plan = fada_newfftplan(2 * n);
+		if (!plan)
+		{
+			printf("FAIL %s n=%u: could not create the plan\n", name, n);
+			return 1;
+		}
+
+		for (i = 0; i < 2*n; ++i)
+			ref[i] = out[i] = input[i];
+
+		fada_butterflies32_scalar(ref, plan->twiddles32, n);
+		kernel(out, plan->twiddles32, n);
+
+		fada_closefftplan(plan);
+
+		peak = 1.f;
+		diff = 0.f;
+		for (i = 0; i < 2*n; ++i)
+		{
+			if (fabsf(ref[i]) > peak)
+				peak = fabsf(ref[i]);
+			if (fabsf(out[i] - ref[i]) > diff)
+				diff = fabsf(out[i] - ref[i]);
+		}
+
+		if (diff > _FADA_TEST_TOLERANCE32 * peak)
+		{
+			printf("FAIL %s n=%u: difference %g, peak %g\n", name, n, diff, peak);
+			failed = 1;
+		}
+	}
+
+	if (!failed)
+		printf("ok   %s\n", name);
+
+	return failed;
+}
+
+
+//////////////////////////////////////////////////
+static fada_Res fada_dftdifference(const fada_Res* input, unsigned int size, const fada_Res* fft, const float* fft32)
+{
+	unsigned int j, k;
+	fada_Res re, im, a, sum = 0., diff = 0.;
+
+	for (j = 0; j < size; ++j)
+		sum += fabs(input[j]);
+
+	for (k = 0; k < size; ++k)
+	{
+		// The plan's twiddles turn positively, so the spectrum comes out with e^(2 pi i jk / size).
+		re = 0.;
+		im = 0.;
+		for (j = 0; j < size; ++j)
+		{
+			a = 2. * _FADA_TEST_PI * (fada_Res)((fada_Pos)j * k % size) / size;
+			re += input[j] * cos(a);
+			im += input[j] * sin(a);
+		}
+
+		if (fft)
+			diff = fmax(diff, fmax(fabs(fft[2*k] - re), fabs(fft[2*k+1] - im)));
+		else
+			diff = fmax(diff, fmax(fabs(fft32[2*k] - re), fabs(fft32[2*k+1] - im)));
+	}
+
+	return sum ? diff / sum : diff;
+}
+
+
+//////////////////////////////////////////////////
+static int fada_testcalcfft(const fada_Res* input, fada_Res* fft, float* fft32)
+{
+	fada_FFTPlan* plan;
+	unsigned int size, i;
+	fada_Res diff, diff32;
+	int failed = 0;
+
+	for (size = 1; size <= _FADA_TEST_MAX_DFT_SIZE; size <<= 1)
+	{
+		plan = fada_newfftplan(size);
+		if (!plan)
+		{
+			printf("FAIL calcfft size=%u: could not create the plan\n", size);
+			return 1;
+		}
+
+		// The real input fills the first half of the buffer, which receives the full complex spectrum.
+		for (i = 0; i < size; ++i)
+		{
+			fft[i] = input[i];
+			fft32[i] = (float)input[i];
+		}
+
+		fada_calcfft_master(fft, plan);
+		fada_calcfft32_master(fft32, plan);
+
+		fada_closefftplan(plan);
+
+		diff = fada_dftdifference(input, size, fft, NULL);
+		diff32 = fada_dftdifference(input, size, NULL, fft32);
+
+		if (diff > _FADA_TEST_DFT_TOLERANCE)
+		{
+			printf("FAIL calcfft size=%u: relative difference %g to the DFT\n", size, diff);
+			failed = 1;
+		}
+
+		if (diff32 > _FADA_TEST_DFT_TOLERANCE32)
+		{
+			printf("FAIL calcfft32 size=%u: relative difference %g to the DFT\n", size, diff32);
+			failed = 1;
+		}
+	}
+
+	if (!failed)
+		printf("ok   calcfft and calcfft32 against the DFT\n");
+
+	return failed;
+}
+
+
+//////////////////////////////////////////////////
+int main()
+{
+	const unsigned int len = 2 * _FADA_TEST_MAX_SIZE;
+	fada_Res* input = (fada_Res*)fada_memalign(len * sizeof(fada_Res), FADA_ALIGNMENT);
+	fada_Res* ref = (fada_Res*)fada_memalign(len * sizeof(fada_Res), FADA_ALIGNMENT);
+	fada_Res* out = (fada_Res*)fada_memalign(len * sizeof(fada_Res), FADA_ALIGNMENT);
+	float* input32 = (float*)fada_memalign(len * sizeof(float), FADA_ALIGNMENT);
+	float* ref32 = (float*)fada_memalign(len * sizeof(float), FADA_ALIGNMENT);
+	float* out32 = (float*)fada_memalign(len * sizeof(float), FADA_ALIGNMENT);
+	fada_FFTPlan* plan = fada_newfftplan(2);
+	unsigned int i;
+	int failed = 0;
+
+#ifdef _FADA_SIMD_X86
+	unsigned int features = fada_cpufeatures();
+#endif
+
+	if (!input || !ref || !out || !input32 || !ref32 || !out32 || !plan)
+	{
+		printf("FAIL out of memory\n");
+		return 1;
+	}
+
+	srand(1);
+	for (i = 0; i < len; ++i)
+	{
+		input[i] = (fada_Res)rand() / RAND_MAX * 2. - 1.;
+		input32[i] = (float)input[i];
+	}
+
+	// The scalar kernels are compared against themselves, which checks the harness.
+	failed |= fada_testbutterflies("scalar", fada_butterflies_scalar, input, ref, out);
+	failed |= fada_testbutterflies32("scalar32", fada_butterflies32_scalar, input32, ref32, out32);
+
+	// The kernels plans pick for this CPU.
+	failed |= fada_testbutterflies("plan", plan->butterflies, input, ref, out);
+	failed |= fada_testbutterflies32("plan32", plan->butterflies32, input32, ref32, out32);
+
+#ifdef _FADA_SIMD_X86
+	if (features & _FADA_CPU_SSE2)
+		failed |= fada_testbutterflies("sse2", fada_butterflies_sse2, input, ref, out);
+	if (features & _FADA_CPU_SSE)
+		failed |= fada_testbutterflies32("sse32", fada_butterflies32_sse, input32, ref32, out32);
+	if (features & _FADA_CPU_AVX)
+	{
+		failed |= fada_testbutterflies("avx", fada_butterflies_avx, input, ref, out);
+		failed |= fada_testbutterflies32("avx32", fada_butterflies32_avx, input32, ref32, out32);
+	}
+#endif
+
+#ifdef _FADA_SIMD_AVX512
+	if (features & _FADA_CPU_AVX512F)
+	{
+		failed |= fada_testbutterflies("avx512", fada_butterflies_avx512, input, ref, out);
+		failed |= fada_testbutterflies32("avx512_32", fada_butterflies32_avx512, input32, ref32, out32);
+	}
+#endif
+
+	failed |= fada_testcalcfft(input, out, out32);
+
+	fada_closefftplan(plan);
+	fada_memfree(input);
+	fada_memfree(ref);
+	fada_memfree(out);
+	fada_memfree(input32);
+	fada_memfree(ref32);
+	fada_memfree(out32);
+
+	return failed;
+}
\ No newline at end of file
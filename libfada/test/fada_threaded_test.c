@@ -0,0 +1,140 @@
+/***********************************************************************************
+ * libfada - Free Audio Detection and Analyzation Library                          *
+ *                                                                                 *
+ * The zlib/libpng License                                                         *
+ * Copyright (c) 2013 Nathan Cousins                                               *
+ *                                                                                 *
+ * This software is provided 'as-is', without any express or implied warranty.     *
+ * In no event will the authors be held liable for any damages arising from the    *
+ * use of this software.                                                           *
+ *                                                                                 *
+ * Permission is granted to anyone to use this software for any purpose,           *
+ * including commercial applications, and to alter it and redistribute it freely,  *
+ * subject to the following restrictions:                                          *
+ *                                                                                 *
+ * 1. The origin of this software must not be misrepresented; you must not claim   *
+ *    that you wrote the original software. If you use this software in a product, *
+ *    an acknowledgment in the product documentation would be appreciated but is   *
+ *    not required.                                                                *
+ *                                                                                 *
+ * 2. Altered source versions must be plainly marked as such, and must not be      *
+ *    misrepresented as being the original software.                               *
+ *                                                                                 *
+ * 3. This notice may not be removed or altered from any source distribution.      *
+ ***********************************************************************************/
+
+// Checks threaded whole-file analysis of a ring stream while another thread keeps pushing to it.
+// Every full window analyzed must match the same window of the complete audio analyzed on its own.
+// Build from the libfada directory and run; exits with a non-zero status on a failure:
+//
+//   cc -std=gnu99 -g -O1 -fsanitize=thread -DFADA_STATIC -DFADA_BUILD -Iinclude -Isrc test/fada_threaded_test.c src/*.c -lm -lpthread -o fada_threaded_test
+
+#include <fada/fada.h>
+#include "fada_atomic.h"
+#include "fada_thread.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+
+#define _FADA_TEST_FRAMES  200000
+#define _FADA_TEST_CHANNELS 2
+#define _FADA_TEST_PUSH    700
+#define _FADA_TEST_HOP     512
+#define _FADA_TEST_THREADS 3
+
+
+static short fada_testsamples[_FADA_TEST_FRAMES * _FADA_TEST_CHANNELS];
+static fada_AtomicPos fada_testpushed;
+
+
+//////////////////////////////////////////////////
+static void fada_pushtest(void* arg)
+{
+	fada_Manager* m = (fada_Manager*)arg;
+	fada_Pos pos, n;
+
+	for (pos = fada_atomicload(&fada_testpushed); pos < _FADA_TEST_FRAMES; pos += n)
+	{
+		n = (_FADA_TEST_FRAMES - pos < _FADA_TEST_PUSH) ? _FADA_TEST_FRAMES - pos : _FADA_TEST_PUSH;
+
+		fada_pushsamples(m, &fada_testsamples[pos * _FADA_TEST_CHANNELS], n * _FADA_TEST_CHANNELS, FADA_FALSE);
+		fada_atomicstore(&fada_testpushed, pos + n);
+	}
+}
+
+
+//////////////////////////////////////////////////
+int main()
+{
+	fada_Manager* m = fada_newmanager();
+	fada_Manager* ref = fada_newmanager();
+	fada_Pos held, i, windows = _FADA_TEST_FRAMES / _FADA_TEST_HOP + 1;
+	fada_Res* beat = (fada_Res*)malloc(windows * sizeof(fada_Res));
+	fada_Res* bass = (fada_Res*)malloc(windows * sizeof(fada_Res));
+	fada_Res* ref_beat = (fada_Res*)malloc(windows * sizeof(fada_Res));
+	fada_Res* ref_bass = (fada_Res*)malloc(windows * sizeof(fada_Res));
+	fada_Thread* producer;
+	fada_Error err;
+	int calls = 0, failed = 0;
+
+	for (i = 0; i < _FADA_TEST_FRAMES * _FADA_TEST_CHANNELS; ++i)
+		fada_testsamples[i] = (short)(sin(i * 0.01) * 12000. + (rand() % 8000) - 4000);
+
+	fada_bindsamples(ref, fada_testsamples, _FADA_TEST_FRAMES * _FADA_TEST_CHANNELS, FADA_FALSE, FADA_TSAMPLE_INT16, 44100, _FADA_TEST_CHANNELS);
+	fada_analyzeall(ref, _FADA_TEST_HOP, FADA_FEATURE_BEAT | FADA_FEATURE_BASS, ref_beat, ref_bass, NULL);
+
+	// The ring holds all of the audio, so nothing analyzed is overwritten.
+	fada_bindringstream(m, FADA_TSAMPLE_INT16, 44100, _FADA_TEST_CHANNELS, _FADA_TEST_FRAMES);
+	fada_pushsamples(m, fada_testsamples, _FADA_TEST_FRAMES / 8 * _FADA_TEST_CHANNELS, FADA_FALSE);
+	fada_atomicstore(&fada_testpushed, _FADA_TEST_FRAMES / 8);
+
+	producer = fada_newthread(fada_pushtest, m);
+	if (!producer)
+	{
+		printf("FAIL could not start the producer\n");
+		return 1;
+	}
+
+	do
+	{
+		// At least these frames are analyzed, the producer may add more before the call takes its snapshot.
+		held = fada_getframecount(m);
+
+		err = fada_analyzeall_threaded(m, _FADA_TEST_HOP, FADA_FEATURE_BEAT | FADA_FEATURE_BASS, beat, bass, NULL, _FADA_TEST_THREADS);
+		if (err != FADA_ERROR_SUCCESS)
+		{
+			printf("FAIL analysis returned %d\n", err);
+			failed = 1;
+			break;
+		}
+
+		// Windows running past the held frames are padded, so only compare those within them.
+		for (i = 0; i * _FADA_TEST_HOP + fada_getwindowframes(m) <= held; ++i)
+		{
+			if (beat[i] != ref_beat[i] || bass[i] != ref_bass[i])
+			{
+				printf("FAIL call %d window %d differs, beat %g/%g bass %g/%g\n", calls, (int)i, beat[i], ref_beat[i], bass[i], ref_bass[i]);
+				failed = 1;
+				break;
+			}
+		}
+
+		++calls;
+	} while (!failed && held < _FADA_TEST_FRAMES);
+
+	fada_jointhread(producer);
+
+	if (!failed)
+		printf("ok   %d calls while pushing\n", calls);
+
+	fada_closemanager(m);
+	fada_closemanager(ref);
+	free(beat);
+	free(bass);
+	free(ref_beat);
+	free(ref_bass);
+
+	return failed;
+}
\ No newline at end of file
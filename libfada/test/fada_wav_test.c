@@ -0,0 +1,155 @@
+/***********************************************************************************
+ * libfada - Free Audio Detection and Analyzation Library                          *
+ *                                                                                 *
+ * The zlib/libpng License                                                         *
+ * Copyright (c) 2013 Nathan Cousins                                               *
+ *                                                                                 *
+ * This software is provided 'as-is', without any express or implied warranty.     *
+ * In no event will the authors be held liable for any damages arising from the    *
+ * use of this software.                                                           *
+ *                                                                                 *
+ * Permission is granted to anyone to use this software for any purpose,           *
+ * including commercial applications, and to alter it and redistribute it freely,  *
+ * subject to the following restrictions:                                          *
+ *                                                                                 *
+ * 1. The origin of this software must not be misrepresented; you must not claim   *
+ *    that you wrote the original software. If you use this software in a product, *
+ *    an acknowledgment in the product documentation would be appreciated but is   *
+ *    not required.                                                                *
+ *                                                                                 *
+ * 2. Altered source versions must be plainly marked as such, and must not be      *
+ *    misrepresented as being the original software.                               *
+ *                                                                                 *
+ * 3. This notice may not be removed or altered from any source distribution.      *
+ ***********************************************************************************/
+
+// Checks WAV header parsing on well-formed, odd and truncated files, both for mapped files and for readers.
+// Every input is held in a block of exactly its own size, so reading past it shows up under AddressSanitizer.
+// Build from the libfada directory and run; exits with a non-zero status on a failure:
+//
+//   cc -std=gnu99 -g -fsanitize=address -DFADA_STATIC -DFADA_BUILD -Iinclude -Isrc test/fada_wav_test.c src/*.c -lm -lpthread -o fada_wav_test
+
+#include <fada/fada.h>
+#include "fada_wav.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+typedef struct fada_TestInput
+{
+	const unsigned char* data;
+	fada_Pos size;
+	fada_Pos pos;
+} fada_TestInput;
+
+
+// 16-bit stereo at 44100 Hz.
+#define _FADA_TEST_FORMAT "fmt \x10\0\0\0\x01\0\x02\0\x44\xAC\0\0\x10\xB1\x02\0\x04\0\x10\0"
+
+
+//////////////////////////////////////////////////
+static fada_Pos fada_readtestinput(void* buffer, fada_Pos size, void* userdata)
+{
+	fada_TestInput* in = (fada_TestInput*)userdata;
+
+	if (size > in->size - in->pos)
+		size = in->size - in->pos;
+
+	memcpy(buffer, &in->data[in->pos], (size_t)size);
+	in->pos += size;
+
+	return size;
+}
+
+
+//////////////////////////////////////////////////
+static int fada_testwav(const char* name, const char* bytes, fada_Pos size, fada_Error expected, fada_Pos expected_size)
+{
+	unsigned char* data = (unsigned char*)malloc((size_t)size);
+	fada_TSample sample_type;
+	unsigned int sample_rate, channels;
+	fada_Pos offset, data_size = 0;
+	fada_Error err, reader_err;
+	fada_TestInput in;
+	fada_Manager* m;
+	fada_Reader* r;
+	int failed = 0;
+
+	memcpy(data, bytes, (size_t)size);
+
+	err = fada_parsewav(data, size, &sample_type, &sample_rate, &channels, &offset, &data_size);
+	if (err != expected || (err == FADA_ERROR_SUCCESS && data_size != expected_size))
+	{
+		printf("FAIL %s: fada_parsewav returned %d with %u data bytes\n", name, err, (unsigned int)data_size);
+		failed = 1;
+	}
+
+	// The streaming parser must agree on whether the file is usable.
+	in.data = data;
+	in.size = size;
+	in.pos = 0;
+
+	m = fada_newmanager();
+	r = fada_newreader(fada_readtestinput, &in, 0, FADA_FALSE);
+	reader_err = fada_bindreader(m, r);
+	if (reader_err != expected)
+	{
+		printf("FAIL %s: fada_bindreader returned %d\n", name, reader_err);
+		failed = 1;
+	}
+
+	fada_closereader(r);
+	fada_closemanager(m);
+	free(data);
+
+	if (!failed)
+		printf("ok   %s\n", name);
+
+	return failed;
+}
+
+
+//////////////////////////////////////////////////
+int main()
+{
+	int failed = 0;
+
+	// A padded odd-length chunk before the format.
+	failed |= fada_testwav("odd chunk with pad",
+		"RIFF\0\0\0\0WAVE" "LIST\x03\0\0\0abc\0" _FADA_TEST_FORMAT "data\x04\0\0\0\x01\0\x02\0",
+		12 + 12 + 24 + 12, FADA_ERROR_SUCCESS, 4);
+
+	// An odd-length chunk ending the file without its pad byte.
+	failed |= fada_testwav("odd chunk missing pad at end",
+		"RIFF\0\0\0\0WAVE" _FADA_TEST_FORMAT "LIST\x03\0\0\0abc",
+		12 + 24 + 11, FADA_ERROR_INVALID_FILE, 0);
+
+	// A chunk claiming more bytes than the file holds.
+	failed |= fada_testwav("chunk past end",
+		"RIFF\0\0\0\0WAVE" _FADA_TEST_FORMAT "LIST\xFF\0\0\0abc",
+		12 + 24 + 11, FADA_ERROR_INVALID_FILE, 0);
+
+	// A chunk header cut off part way.
+	failed |= fada_testwav("truncated chunk header",
+		"RIFF\0\0\0\0WAVE" _FADA_TEST_FORMAT "dat",
+		12 + 24 + 3, FADA_ERROR_INVALID_FILE, 0);
+
+	// Sample data cut off by the end of the file is clamped.
+	failed |= fada_testwav("truncated data",
+		"RIFF\0\0\0\0WAVE" _FADA_TEST_FORMAT "data\x00\x10\0\0\x01\0\x02\0",
+		12 + 24 + 12, FADA_ERROR_SUCCESS, 4);
+
+	// Sample data before the format.
+	failed |= fada_testwav("data before format",
+		"RIFF\0\0\0\0WAVE" "data\x04\0\0\0\x01\0\x02\0" _FADA_TEST_FORMAT,
+		12 + 12 + 24, FADA_ERROR_INVALID_FILE, 0);
+
+	// Not a WAV file at all.
+	failed |= fada_testwav("not a wav file",
+		"RIFX\0\0\0\0WAVE",
+		12, FADA_ERROR_INVALID_FILE, 0);
+
+	return failed;
+}
\ No newline at end of file